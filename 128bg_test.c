@@ -22,12 +22,60 @@
 			printf("heap error line: %d\n", __LINE__); \
 			abort();}
 
+// writes a raw compact record (tag with s = 0, then I and F as varints),
+// so that the reader can be fed records the writer never makes
+static int test_put_compact(CC_SFILE *f, int neg, unsigned long long ip,
+                            unsigned long long fp) {
+	unsigned long long v[2] = {ip, fp};
+	if (CCutil_swrite_uchar(f, (unsigned char) (neg | (ip ? 2 : 0) | (fp ? 4 : 0)))) return 1;
+	for (int k = 0; k < 2; k++) {
+		if (!v[k]) continue;
+		while (v[k] >= 0x80) {
+			if (CCutil_swrite_uchar(f, (unsigned char) (v[k] | 0x80))) return 1;
+			v[k] >>= 7;
+		}
+		if (CCutil_swrite_uchar(f, (unsigned char) v[k])) return 1;
+	}
+	return 0;
+}
+
+static CCbigguy_atomic test_atomic, test_atomic_max;
+
+static void atomic_task(void *arg, int t) {
+	const CCbigguy *y = (const CCbigguy *) arg;
+	for (int k = 0; k < 1000; k++) {
+		CCbigguy_atomic_addmult(&test_atomic, y[(t + k) % 7], k - t);
+		CCbigguy_atomic_max(&test_atomic_max, y[(t + k) % 7]);
+	}
+}
+
+enum { atomic_edge_n = 20000 };
+static int test_atomic_fail[4];
+
+// four tasks at the top of the range: +1/2 then -1/2 keeps the sum at most
+// MAXBIGGUY, and the maxima climb to MAXBIGGUY in steps of 1/2
+static void atomic_edge_task(void *arg, int t) {
+	CCbigguy half = *(const CCbigguy *) arg;
+	CCbigguy v;
+	int fail = 0;
+	for (int k = 0; k < atomic_edge_n; k++) {
+		fail |= CCbigguy_atomic_add_chk(&test_atomic, half);
+		fail |= CCbigguy_atomic_addmult_chk(&test_atomic, half, -1);
+	}
+	for (int j = t; j < atomic_edge_n; j += 4) {
+		v = CCbigguy_MAXBIGGUY;
+		CCbigguy_addmult(&v, half, j - (atomic_edge_n - 1));
+		CCbigguy_atomic_max(&test_atomic_max, v);
+	}
+	test_atomic_fail[t] = fail;
+}
+
 int main(void) {
 
 	// write 7 bigguys to a file and create array x[6] of bigguys
-	const int no_bigguys = 7;
+	enum { no_bigguys = 7 };
 	CC_SFILE *ccfile = CCutil_sopen ("tempfile", "w");
-	CCbigguy *pos_i_bg = malloc(sizeof(CCbigguy) * 6);
+	CCbigguy *pos_i_bg = malloc(sizeof(CCbigguy) * no_bigguys);
 	SAFE_MALLOC(pos_i_bg);
 	double pos_i_d[no_bigguys] = {(double) 0x7fff0000, (double) 0xffff,
 	(double) 0x7f000000, (double) 0xff0000, (double) 0xff, (double) 0xff00,
@@ -246,6 +294,1136 @@ int main(void) {
 	else
 		printf("PASS max to -max (int)\n");
 
+	// multiplying carry from flo to ihi
+	*temp = CCbigguy_dtobigguy((double) 0x0.00000001p0);
+	*temp1 = CCbigguy_dtobigguy((double) 0x7fff.ffffffffp0);
+	*expected = CCbigguy_dtobigguy((double) -0x3fffffff7fff.8p0);
+	CCbigguy_addmult(temp, *temp1, (int) -0x7fffffff);
+	if (0 != CCbigguy_cmp(*temp, *expected)) {
+		printf("multiplying carry from flo to ihi failed\n");
+	}
+	else
+		printf("PASS carry from flo to ihi (mult)\n");
+
+	// add max to min
+	*temp = CCbigguy_MAXBIGGUY;
+	*expected = CCbigguy_ZERO;
+	CCbigguy_add(temp, CCbigguy_MINBIGGUY);
+	if (0 != CCbigguy_cmp(*temp, *expected)) {
+		printf("adding max to min failed\n");
+	}
+	else
+		printf("PASS max + min\n");
+
+	// subtract min from -1
+	*temp = CCbigguy_dtobigguy(-1.0);
+	*expected = CCbigguy_MAXBIGGUY;
+	CCbigguy_sub(temp, CCbigguy_MINBIGGUY);
+	CCbigguy_add(expected, CCbigguy_MINBIGGUY);
+	CCbigguy_sub(expected, CCbigguy_ONE);
+	CCbigguy_add(expected, CCbigguy_MAXBIGGUY);
+	if (0 != CCbigguy_cmp(*temp, *expected)) {
+		printf("subtracting min from -1 failed\n");
+	}
+	else
+		printf("PASS -1 - min\n");
+
+	// dot product with an out of range intermediate sum
+	{
+		CCbigguy y[3];
+		int m[3] = {2, -2, 3};
+		int ind[3] = {2, 0, 1};
+		y[0] = CCbigguy_MAXBIGGUY;
+		y[1] = CCbigguy_MAXBIGGUY;
+		y[2] = CCbigguy_dtobigguy(0.5);
+		*temp = CCbigguy_dtobigguy(-1.0);
+		*expected = CCbigguy_dtobigguy(0.5);
+		CCbigguy_dot(temp, y, m, 3);
+		if (0 != CCbigguy_cmp(*temp, *expected)) {
+			printf("dot product failed\n");
+		}
+		else
+			printf("PASS dot product\n");
+
+		// y[2]*2 + y[0]*-2 + y[1]*3 = 1 + max
+		*temp = CCbigguy_MINBIGGUY;
+		*expected = CCbigguy_ONE;
+		CCbigguy_dot_sparse(temp, y, ind, m, 3);
+		if (0 != CCbigguy_cmp(*temp, *expected)) {
+			printf("sparse dot product failed\n");
+		}
+		else
+			printf("PASS sparse dot product\n");
+	}
+
+	// vector addmult agrees with the scalar routine
+	{
+		CCbigguy_vec vx, vy;
+		int m[37], i, bad = 0;
+		SAFE(CCbigguy_vec_init(&vx, 37));
+		SAFE(CCbigguy_vec_init(&vy, 37));
+		for (i = 0; i < 37; i++) {
+			CCbigguy_vec_set(&vx, i, CCbigguy_dtobigguy((double) (i - 18) * 0x1.23456789p40));
+			CCbigguy_vec_set(&vy, i, CCbigguy_dtobigguy((double) (18 - i) * 0x1.fedcba98p-20));
+			m[i] = (i % 2) ? -0x7fffffff + i : 0x7fffffff - i;
+		}
+		if (CCbigguy_vec_addmult(&vx, &vy, m)) bad = 1;
+		for (i = 0; i < 37; i++) {
+			*temp = CCbigguy_dtobigguy((double) (i - 18) * 0x1.23456789p40);
+			CCbigguy_addmult(temp, CCbigguy_vec_get(&vy, i), m[i]);
+			if (0 != CCbigguy_cmp(*temp, CCbigguy_vec_get(&vx, i))) bad = 1;
+		}
+		if (bad) {
+			printf("vector addmult failed\n");
+		}
+		else
+			printf("PASS vector addmult\n");
+
+		// overflow in one element sets the flag
+		CCbigguy_vec_set(&vx, 20, CCbigguy_MAXBIGGUY);
+		CCbigguy_vec_set(&vy, 20, CCbigguy_ONE);
+		if (!CCbigguy_vec_add(&vx, &vy)) {
+			printf("vector overflow flag failed\n");
+		}
+		else
+			printf("PASS vector overflow flag\n");
+		CCbigguy_vec_free(&vx);
+		CCbigguy_vec_free(&vy);
+	}
+
+	// non-aborting overflow leaves x unchanged
+	{
+		int ovf = 0;
+		*temp = CCbigguy_dtobigguy(0x1p62);
+		*temp1 = CCbigguy_dtobigguy(0x1p61);
+		*expected = *temp;
+		ovf |= CCbigguy_addmult_chk(temp, *temp1, 3);
+		if (!ovf || 0 != CCbigguy_cmp(*temp, *expected)) {
+			printf("non-aborting addmult failed\n");
+		}
+		else
+			printf("PASS non-aborting addmult\n");
+
+		*temp = CCbigguy_MAXBIGGUY;
+		ovf = CCbigguy_dtobigguy_chk(-1e300, temp);
+		ovf |= CCbigguy_add_chk(temp, CCbigguy_ONE);
+		ovf |= CCbigguy_ceil_chk(temp);
+		if (!ovf || 0 != CCbigguy_cmp(*temp, CCbigguy_MAXBIGGUY)) {
+			printf("sticky overflow failed\n");
+		}
+		else
+			printf("PASS sticky overflow\n");
+	}
+
+	// hybrid promotes past 32.32 and comes back, matching plain addmult
+	{
+		CCbigguy_hybrid h;
+		int k, bad = 0;
+		*temp = CCbigguy_dtobigguy(1.5);
+		CCbigguy_hybrid_init(&h, *temp);
+		*temp1 = CCbigguy_dtobigguy(0x1.4p29);
+		for (k = 0; k < 12; k++) {
+			CCbigguy_addmult(temp, *temp1, (k < 6) ? 0x7fffffff : -0x7fffffff);
+			CCbigguy_hybrid_addmult(&h, *temp1, (k < 6) ? 0x7fffffff : -0x7fffffff);
+			if (0 != CCbigguy_cmp(*temp, CCbigguy_hybrid_get(&h))) bad = 1;
+		}
+		if (h.isbig) bad = 1;
+		CCbigguy_hybrid_add(&h, pos_i_bg[2]);
+		CCbigguy_add(temp, pos_i_bg[2]);
+		if (0 != CCbigguy_hybrid_cmp(&h, *temp)) bad = 1;
+		if (bad) {
+			printf("hybrid addmult failed\n");
+		}
+		else
+			printf("PASS hybrid addmult\n");
+	}
+
+	// array writes are readable one at a time, and the other way round
+	{
+		enum { narr = 600 };
+		CCbigguy *arr = malloc(sizeof(CCbigguy) * narr);
+		CCbigguy *back = malloc(sizeof(CCbigguy) * narr);
+		int bad = 0;
+		SAFE_MALLOC(arr);
+		SAFE_MALLOC(back);
+		for (int i = 0; i < narr; i++) {
+			arr[i] = CCbigguy_dtobigguy((i - 300) * 0x1.3579bdp33);
+			arr[i].flo = 0x01020304u * i;
+		}
+		ccfile = CCutil_sopen ("tempfile", "w");
+		SAFE(CCbigguy_swrite_array (ccfile, arr, 400));
+		for (int i = 400; i < narr; i++) {
+			SAFE(CCbigguy_swrite (ccfile, arr[i]));
+		}
+		SAFE(CCutil_sclose (ccfile));
+		nccfile = CCutil_sopen ("tempfile", "r");
+		for (int i = 0; i < 3; i++) {
+			SAFE(CCbigguy_sread (nccfile, &back[i]));
+		}
+		SAFE(CCbigguy_sread_array (nccfile, back + 3, narr - 3));
+		SAFE(CCutil_sclose (nccfile));
+		for (int i = 0; i < narr; i++) {
+			if (0 != CCbigguy_cmp(arr[i], back[i])) bad = 1;
+		}
+		if (bad) {
+			printf("array read/write failed\n");
+		}
+		else
+			printf("PASS array read/write\n");
+
+		// the mapped array is the written one, and corruption is caught
+		{
+			CCbigguy_map map;
+			FILE *fp;
+			bad = 0;
+			SAFE(CCbigguy_map_write ("tempfile", arr, narr));
+			SAFE(CCbigguy_map_open (&map, "tempfile", 1));
+			if (map.n != narr || ((size_t) map.x & 15)) bad = 1;
+			for (int i = 0; !bad && i < narr; i++) {
+				if (0 != CCbigguy_cmp(arr[i], map.x[i])) bad = 1;
+			}
+			CCbigguy_map_close (&map);
+			if (!CCbigguy_map_write ("tempfile", arr, -1)) bad = 1;
+			SAFE(CCbigguy_map_open (&map, "tempfile", 1));
+			if (map.n != narr) bad = 1;
+			CCbigguy_map_close (&map);
+			fp = fopen ("tempfile", "r+b");
+			SAFE_MALLOC(fp);
+			fseek (fp, 64 + 16 * 123 + 5, SEEK_SET);
+			fputc (0x5a, fp);
+			fclose (fp);
+			if (!CCbigguy_map_open (&map, "tempfile", 1)) {
+				bad = 1;
+				CCbigguy_map_close (&map);
+			}
+			if (bad) {
+				printf("mapped array failed\n");
+			}
+			else
+				printf("PASS mapped array\n");
+		}
+
+		// compact streams round trip, mixed with single values, and are small
+		{
+			long len;
+			FILE *fp;
+			bad = 0;
+			arr[7] = CCbigguy_MAXBIGGUY;
+			arr[8] = CCbigguy_MINBIGGUY;
+			arr[9] = CCbigguy_ZERO;
+			ccfile = CCutil_sopen ("tempfile", "w");
+			SAFE(CCbigguy_swrite_compact (ccfile, arr[0]));
+			SAFE(CCbigguy_swrite_array_fmt (ccfile, arr + 1, narr - 1, CCbigguy_FMT_COMPACT));
+			SAFE(CCutil_sclose (ccfile));
+			nccfile = CCutil_sopen ("tempfile", "r");
+			SAFE(CCbigguy_sread_array_fmt (nccfile, back, narr - 1, CCbigguy_FMT_COMPACT));
+			SAFE(CCbigguy_sread_compact (nccfile, &back[narr - 1]));
+			SAFE(CCutil_sclose (nccfile));
+			for (int i = 0; i < narr; i++) {
+				if (0 != CCbigguy_cmp(arr[i], back[i])) bad = 1;
+			}
+
+			// small duals with short fractions take at most 3 bytes each
+			for (int i = 0; i < narr; i++) {
+				arr[i] = CCbigguy_dtobigguy((i - 300) / 4.0);
+			}
+			ccfile = CCutil_sopen ("tempfile", "w");
+			SAFE(CCbigguy_swrite_array_fmt (ccfile, arr, narr, CCbigguy_FMT_COMPACT));
+			SAFE(CCutil_sclose (ccfile));
+			fp = fopen ("tempfile", "rb");
+			SAFE_MALLOC(fp);
+			fseek (fp, 0L, SEEK_END);
+			len = ftell (fp);
+			fclose (fp);
+
+			// records just past the two's complement range are rejected,
+			// the ones at its ends are not, and its minimum (one below
+			// MINBIGGUY) round trips; the integer part has 32 bits with a
+			// builtin bigguy, 64 otherwise
+			{
+#ifdef CC_BIGGUY_BUILTIN
+				unsigned long long ibig = 0x80000000ULL;
+				unsigned long long fmax = 0xffffffff00000000ULL;
+				CCbigguy low = CCbigguy_MINBIGGUY - 1;
+#else
+				unsigned long long ibig = 0x8000000000000000ULL;
+				unsigned long long fmax = 0xffffffffffffffffULL;
+				CCbigguy low = {0x80000000, 0, 0, 0};
+#endif
+				CCbigguy x = CCbigguy_ZERO;
+				ccfile = CCutil_sopen ("tempfile", "w");
+				SAFE(test_put_compact (ccfile, 1, ibig, 0x8000000000000000ULL));
+				SAFE(test_put_compact (ccfile, 0, ibig, 0));
+				SAFE(test_put_compact (ccfile, 1, ibig - 1, fmax));
+				SAFE(test_put_compact (ccfile, 1, ibig, 0));
+				SAFE(CCbigguy_swrite_compact (ccfile, low));
+				SAFE(CCutil_sclose (ccfile));
+				nccfile = CCutil_sopen ("tempfile", "r");
+				if (!CCbigguy_sread_compact (nccfile, &x)) bad = 1;
+				if (!CCbigguy_sread_compact (nccfile, &x)) bad = 1;
+				if (CCbigguy_sread_compact (nccfile, &x)) bad = 1;
+				if (0 != CCbigguy_cmp(x, CCbigguy_MINBIGGUY)) bad = 1;
+				x = CCbigguy_ZERO;
+				if (CCbigguy_sread_compact (nccfile, &x)) bad = 1;
+				if (0 != CCbigguy_cmp(x, low)) bad = 1;
+				x = CCbigguy_ZERO;
+				if (CCbigguy_sread_compact (nccfile, &x)) bad = 1;
+				if (0 != CCbigguy_cmp(x, low)) bad = 1;
+				SAFE(CCutil_sclose (nccfile));
+			}
+			if (bad || len > 3 * narr) {
+				printf("compact read/write failed\n");
+			}
+			else
+				printf("PASS compact read/write\n");
+		}
+		free(arr);
+		free(back);
+	}
+
+	// double conversions are exact where they can be, and round to even
+	{
+		double d[6] = {0x1.fffffffffffffp62, -0x1.fffffffffffffp-12,
+			0x1.23456789abcdep-12, -0x1p-64, 0x1.8p-65, 0x1p-65};
+		CCbigguy x[6];
+		double back[6];
+		int bad = 0;
+		if (CCbigguy_dtobigguy_array(d, x, 6)) bad = 1;
+		CCbigguy_bigguytod_array(x, back, 6);
+		for (int i = 0; i < 4; i++) {
+			if (back[i] != d[i]) bad = 1;
+		}
+		if (back[4] != 0x1p-64 || back[5] != 0.0) bad = 1;
+		if (CCbigguy_bigguytod(CCbigguy_MAXBIGGUY) != 0x1p63) bad = 1;
+		if (CCbigguy_bigguytod(CCbigguy_MINBIGGUY) != -0x1p63) bad = 1;
+
+		// 2^53 + 1 ties down to 2^53, and 2^53 + 3 up to 2^53 + 4
+		*temp = CCbigguy_itobigguy(1 << 26);
+		CCbigguy_addmult(temp, CCbigguy_itobigguy(1 << 26), (1 << 27) - 1);
+		CCbigguy_add(temp, CCbigguy_ONE);
+		if (CCbigguy_bigguytod(*temp) != 0x1p53) bad = 1;
+		CCbigguy_addmult(temp, CCbigguy_ONE, 2);
+		if (CCbigguy_bigguytod(*temp) != 0x1p53 + 4) bad = 1;
+
+		d[0] = 0x1p63;
+		if (!CCbigguy_dtobigguy_array(d, x, 6) ||
+		    0 != CCbigguy_cmp(x[0], CCbigguy_dtobigguy(0x1.fffffffffffffp62))) bad = 1;
+		if (bad) {
+			printf("double conversion failed\n");
+		}
+		else
+			printf("PASS double conversion\n");
+	}
+
+	// exact double sums cancel huge terms and round only at the end
+	{
+		CCbigguy_dsum ds;
+		double d[5] = {0x1p900, 0x1.8p-3, -0x1p900, 0x1p-70, -0x1.8p-30};
+		int m[5] = {3, -0x7fffffff, 3, 64, 5};
+		int bad = 0;
+		CCbigguy_dsum_init(&ds);
+		CCbigguy_dsum_add_array(&ds, d, 5);
+		for (int i = 0; i < 63; i++) CCbigguy_dsum_add(&ds, 0x1p-70);
+		*expected = CCbigguy_dtobigguy(0x1.8p-3);
+		CCbigguy_sub(expected, CCbigguy_dtobigguy(0x1.8p-30));
+		CCbigguy_add(expected, CCbigguy_dtobigguy(0x1p-64));
+		if (CCbigguy_dsum_get(&ds, temp) || 0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+
+		CCbigguy_dsum_init(&ds);
+		CCbigguy_dsum_dot(&ds, d, m, 5);
+		CCbigguy_dsum_addmult(&ds, 0x1p900, -6);
+		CCbigguy_dsum_addmult(&ds, 0x1p899, 12);
+		*expected = CCbigguy_ZERO;
+		CCbigguy_addmult(expected, CCbigguy_dtobigguy(0x1.8p-3), -0x7fffffff);
+		CCbigguy_add(expected, CCbigguy_dtobigguy(0x1p-64));
+		CCbigguy_addmult(expected, CCbigguy_dtobigguy(-0x1.8p-30), 5);
+		if (CCbigguy_dsum_get(&ds, temp) || 0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+
+		// out of range in the middle is fine, and the sum is kept exactly
+		CCbigguy_dsum_add(&ds, 0x1p63);
+		CCbigguy_dsum_add(&ds, 0x1p63);
+		if (!CCbigguy_dsum_get(&ds, temp)) bad = 1;
+		CCbigguy_dsum_addmult(&ds, 0x1p63, -2);
+		if (CCbigguy_dsum_get(&ds, temp) || 0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+		if (bad) {
+			printf("double sum failed\n");
+		}
+		else
+			printf("PASS double sum\n");
+	}
+
+	// parallel reductions match the serial dot product for any pool
+	{
+		enum { npar = 100003 };
+		CCbigguy *y = malloc(sizeof(CCbigguy) * npar);
+		int *m = malloc(sizeof(int) * npar);
+		int *ind = malloc(sizeof(int) * npar);
+		int *one = malloc(sizeof(int) * npar);
+		CCbigguy_pool *pool;
+		int bad = 0;
+		SAFE_MALLOC(y);
+		SAFE_MALLOC(m);
+		SAFE_MALLOC(ind);
+		SAFE_MALLOC(one);
+		for (int i = 0; i < npar; i++) {
+			y[i] = CCbigguy_dtobigguy(((i * 7919) % 20011 - 10005) * 0x1.9e3779b9p-10);
+			y[i].flo = 0x9e3779b9u * i;
+			m[i] = (i % 3) ? 0x7fffffff - i : -0x7fffffff + i;
+			one[i] = 1;
+			ind[i] = (int) ((i * 40009LL) % npar);
+			if (ind[i] == 17 || ind[i] == npar - 5) ind[i] = i % 17;
+		}
+		ind[17] = 17;
+		ind[npar - 5] = npar - 5;
+		y[17] = CCbigguy_MAXBIGGUY;
+		y[npar - 5] = CCbigguy_MAXBIGGUY;
+		m[npar - 5] = -m[17];
+		for (int t = 0; t <= 4; t += 3) {
+			SAFE(CCbigguy_pool_init(&pool, t ? t : 1));
+			*temp = CCbigguy_dtobigguy(0.25);
+			*expected = *temp;
+			CCbigguy_dot(expected, y, m, npar);
+			CCbigguy_par_dot(pool, temp, y, m, npar);
+			if (0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+			*temp = *expected = CCbigguy_ZERO;
+			CCbigguy_dot_sparse(expected, y, ind, m, npar);
+			CCbigguy_par_dot_sparse(pool, temp, y, ind, m, npar);
+			if (0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+			*temp = *expected = CCbigguy_MINBIGGUY;
+			if (CCbigguy_par_sum_chk(pool, temp, y, npar) !=
+			    CCbigguy_dot_chk(expected, y, one, npar)) bad = 1;
+			if (0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+			*temp = *expected = CCbigguy_MAXBIGGUY;
+			if (CCbigguy_par_sum_chk(pool, temp, y, npar) !=
+			    CCbigguy_dot_chk(expected, y, one, npar)) bad = 1;
+			if (0 != CCbigguy_cmp(*temp, *expected)) bad = 1;
+			CCbigguy_pool_free(pool);
+		}
+		if (bad) {
+			printf("parallel reduction failed\n");
+		}
+		else
+			printf("PASS parallel reduction\n");
+		free(y);
+		free(m);
+		free(ind);
+		free(one);
+	}
+
+	// sparse matrix times duals, row by row, and the fused bound test
+	{
+		enum { nrows = 3001, ncols = 777, rowlen = 9 };
+		int *rowbeg = malloc(sizeof(int) * (nrows + 1));
+		int *colind = malloc(sizeof(int) * nrows * rowlen);
+		int *val = malloc(sizeof(int) * nrows * rowlen);
+		int *viol = malloc(sizeof(int) * nrows);
+		CCbigguy *pi = malloc(sizeof(CCbigguy) * ncols);
+		CCbigguy *out = malloc(sizeof(CCbigguy) * nrows);
+		CCbigguy *bound = malloc(sizeof(CCbigguy) * nrows);
+		CCbigguy_pool *pool;
+		int nviol, k = 0, bad = 0;
+		SAFE_MALLOC(rowbeg);
+		SAFE_MALLOC(colind);
+		SAFE_MALLOC(val);
+		SAFE_MALLOC(viol);
+		SAFE_MALLOC(pi);
+		SAFE_MALLOC(out);
+		SAFE_MALLOC(bound);
+		for (int j = 0; j < ncols; j++) {
+			pi[j] = CCbigguy_dtobigguy((j - 388) * 0x1.5555p-3);
+			pi[j].flo = 0x2545f491u * j;
+		}
+		for (int i = 0; i < nrows; i++) {
+			rowbeg[i] = k;
+			for (int r = 0; r < i % rowlen; r++, k++) {
+				colind[k] = (i * 31 + r * 97) % ncols;
+				val[k] = (r % 2) ? 1 + i : -3 - r * i;
+			}
+			bound[i] = CCbigguy_itobigguy((i % 5 - 2) * 1000);
+		}
+		rowbeg[nrows] = k;
+		SAFE(CCbigguy_pool_init(&pool, 3));
+		CCbigguy_spmv(pool, nrows, rowbeg, colind, val, pi, out);
+		nviol = CCbigguy_spmv_viol(pool, nrows, rowbeg, colind, val, pi, bound, viol);
+		k = 0;
+		for (int i = 0; i < nrows; i++) {
+			*temp = CCbigguy_ZERO;
+			CCbigguy_dot_sparse(temp, pi, colind + rowbeg[i], val + rowbeg[i],
+				rowbeg[i + 1] - rowbeg[i]);
+			if (0 != CCbigguy_cmp(*temp, out[i])) bad = 1;
+			if (CCbigguy_cmp(*temp, bound[i]) > 0) {
+				if (k >= nviol || viol[k] != i) bad = 1;
+				k++;
+			}
+		}
+		if (k != nviol || k == 0 || k == nrows) bad = 1;
+
+		// a row that is out of range is still compared exactly
+		pi[0] = CCbigguy_MAXBIGGUY;
+		colind[rowbeg[1]] = 0;
+		val[rowbeg[1]] = 2;
+		bound[0] = CCbigguy_ZERO;
+		bound[1] = CCbigguy_MAXBIGGUY;
+		if (!CCbigguy_spmv_chk(pool, nrows, rowbeg, colind, val, pi, out)) bad = 1;
+		nviol = CCbigguy_spmv_viol(pool, nrows, rowbeg, colind, val, pi, bound, viol);
+		if (nviol < 1 || viol[0] != 1) bad = 1;
+		CCbigguy_pool_free(pool);
+		if (bad) {
+			printf("sparse matrix product failed\n");
+		}
+		else
+			printf("PASS sparse matrix product\n");
+		free(rowbeg);
+		free(colind);
+		free(val);
+		free(viol);
+		free(pi);
+		free(out);
+		free(bound);
+	}
+
+	// concurrent atomic updates give the serial sum and maximum
+	{
+		CCbigguy_pool *pool;
+		int bad = 0;
+		SAFE(CCbigguy_pool_init(&pool, 4));
+		CCbigguy_atomic_init(&test_atomic, CCbigguy_dtobigguy(-0.5));
+		CCbigguy_atomic_init(&test_atomic_max, CCbigguy_MINBIGGUY);
+		CCbigguy_pool_run(pool, 64, atomic_task, pos_i_bg);
+		*expected = CCbigguy_dtobigguy(-0.5);
+		for (int t = 0; t < 64; t++) {
+			for (int k = 0; k < 1000; k++) {
+				CCbigguy_addmult(expected, pos_i_bg[(t + k) % 7], k - t);
+			}
+		}
+		if (0 != CCbigguy_cmp(CCbigguy_atomic_load(&test_atomic), *expected)) bad = 1;
+		if (0 != CCbigguy_cmp(CCbigguy_atomic_load(&test_atomic_max), pos_i_bg[0])) bad = 1;
+		CCbigguy_pool_free(pool);
+
+		// an overflowing update changes nothing
+		CCbigguy_atomic_init(&test_atomic, CCbigguy_MAXBIGGUY);
+		if (!CCbigguy_atomic_add_chk(&test_atomic, CCbigguy_ONE)) bad = 1;
+		if (CCbigguy_atomic_addmult_chk(&test_atomic, CCbigguy_ONE, -3)) bad = 1;
+		*expected = CCbigguy_MAXBIGGUY;
+		CCbigguy_sub(expected, CCbigguy_itobigguy(3));
+		if (0 != CCbigguy_cmp(CCbigguy_atomic_load(&test_atomic), *expected)) bad = 1;
+
+		// concurrent updates next to overflow match the serial results
+		{
+			CCbigguy half = CCbigguy_dtobigguy(0.5);
+			SAFE(CCbigguy_pool_init(&pool, 4));
+			*expected = CCbigguy_MAXBIGGUY;
+			CCbigguy_addmult(expected, half, -4);
+			CCbigguy_atomic_init(&test_atomic, *expected);
+			CCbigguy_atomic_init(&test_atomic_max, CCbigguy_MINBIGGUY);
+			CCbigguy_pool_run(pool, 4, atomic_edge_task, &half);
+			for (int t = 0; t < 4; t++) {
+				if (test_atomic_fail[t]) bad = 1;
+			}
+			if (0 != CCbigguy_cmp(CCbigguy_atomic_load(&test_atomic), *expected)) bad = 1;
+			if (0 != CCbigguy_cmp(CCbigguy_atomic_load(&test_atomic_max), CCbigguy_MAXBIGGUY)) bad = 1;
+			CCbigguy_pool_free(pool);
+		}
+		if (bad) {
+			printf("atomic bigguy failed\n");
+		}
+		else
+			printf("PASS atomic bigguy\n");
+	}
+
+	// selection and radix sorts agree with CCbigguy_cmp
+	{
+		enum { nsort = 5003, ksort = 37 };
+		CCbigguy *x = malloc(sizeof(CCbigguy) * nsort);
+		CCbigguy *xs = malloc(sizeof(CCbigguy) * nsort);
+		int *perm = malloc(sizeof(int) * nsort);
+		int top[ksort];
+		CCbigguy edge[7];
+		int bad = 0, amin = 0, amax = 0, below = 0;
+		SAFE_MALLOC(x);
+		SAFE_MALLOC(xs);
+		SAFE_MALLOC(perm);
+
+		edge[0] = CCbigguy_MINBIGGUY;
+		edge[1] = CCbigguy_dtobigguy(-1.0);
+		edge[2] = CCbigguy_ZERO;
+		CCbigguy_sub(&edge[2], CCbigguy_dtobigguy(0x1p-64));
+		edge[3] = CCbigguy_ZERO;
+		edge[4] = CCbigguy_dtobigguy(0x1p-64);
+		edge[5] = CCbigguy_ONE;
+		edge[6] = CCbigguy_MAXBIGGUY;
+		for (int i = 0; i < 7; i++) {
+			for (int j = 0; j < 7; j++) {
+				if (CCbigguy_cmp(edge[i], edge[j]) != (i > j) - (i < j)) bad = 1;
+			}
+		}
+
+		for (int i = 0; i < nsort; i++) {
+			x[i] = CCbigguy_dtobigguy(((i * 7919) % 1009 - 504) * 0x1.9e3779b9p20);
+			if (i % 5) x[i].flo = 0x9e3779b9u * (i % 13);
+			if (i % 7 == 3) x[i] = edge[i % 7];
+			perm[i] = i;
+		}
+		x[nsort / 2] = CCbigguy_MINBIGGUY;
+		x[nsort / 3] = CCbigguy_MAXBIGGUY;
+		for (int i = 1; i < nsort; i++) {
+			if (CCbigguy_cmp(x[i], x[amin]) < 0) amin = i;
+			if (CCbigguy_cmp(x[i], x[amax]) > 0) amax = i;
+		}
+		for (int i = 0; i < nsort; i++) {
+			if (CCbigguy_cmp(x[i], edge[4]) < 0) below++;
+		}
+		if (CCbigguy_array_argmin(x, nsort) != amin) bad = 1;
+		if (CCbigguy_array_argmax(x, nsort) != amax) bad = 1;
+		if (CCbigguy_cmp(CCbigguy_array_min(x, nsort), x[amin])) bad = 1;
+		if (CCbigguy_cmp(CCbigguy_array_max(x, nsort), x[amax])) bad = 1;
+		if (CCbigguy_array_count_below(x, nsort, edge[4]) != below) bad = 1;
+		if (CCbigguy_array_argmin(x, 0) != -1) bad = 1;
+
+		for (int n = 20; n <= nsort; n += nsort - 20) {
+			memcpy(xs, x, sizeof(CCbigguy) * n);
+			for (int i = 0; i < n; i++) perm[i] = i;
+			SAFE(CCbigguy_radixsort(xs, n));
+			SAFE(CCbigguy_perm_radixsort(perm, x, n));
+			for (int i = 0; i < n; i++) {
+				if (CCbigguy_cmp(xs[i], x[perm[i]])) bad = 1;
+				if (i == 0) continue;
+				int c = CCbigguy_cmp(xs[i-1], xs[i]);
+				if (c > 0 || (c == 0 && perm[i-1] > perm[i])) bad = 1;
+			}
+			int k = CCbigguy_array_topk(x, n, ksort, top);
+			if (k != (n < ksort ? n : ksort)) bad = 1;
+			for (int i = 0; i < k; i++) {
+				if (top[i] != perm[i]) bad = 1;
+			}
+		}
+		if (bad) {
+			printf("bigguy selection and sorting failed\n");
+		}
+		else
+			printf("PASS bigguy selection and sorting\n");
+		free(x);
+		free(xs);
+		free(perm);
+	}
+
+	// every kernel set this CPU can run gives the generic results
+	{
+		static const char *cpus[] = {"generic", "int128", "int128-bmi2"};
+		enum { ncpu = 4099 };
+		CCbigguy *y = malloc(sizeof(CCbigguy) * ncpu);
+		CCbigguy *z = malloc(sizeof(CCbigguy) * ncpu);
+		double *d = malloc(sizeof(double) * ncpu);
+		double *dz = malloc(sizeof(double) * ncpu);
+		int *m = malloc(sizeof(int) * ncpu);
+		int *ind = malloc(sizeof(int) * ncpu);
+		CCbigguy want[4], got[4];
+		int wantovf[4], gotovf[4];
+		int bad = 0;
+		SAFE_MALLOC(y);
+		SAFE_MALLOC(z);
+		SAFE_MALLOC(d);
+		SAFE_MALLOC(dz);
+		SAFE_MALLOC(m);
+		SAFE_MALLOC(ind);
+		for (int i = 0; i < ncpu; i++) {
+			y[i] = CCbigguy_dtobigguy(((i * 7919) % 20011 - 10005) * 0x1.9e3779b9p0);
+			y[i].flo = 0x9e3779b9u * i;
+			m[i] = (i % 3) ? 0x7fffffff - i : -0x7fffffff + i;
+			ind[i] = (int) ((i * 409LL) % ncpu);
+			d[i] = ((i * 40503) % 65521 - 32760) * 0x1.3c6ef372fe94fp-40;
+		}
+		d[0] = 0x1p63;
+		d[1] = 0x1.fffffffffffffp62;
+		d[2] = 0x1p-65 * 3;
+
+		for (int c = 0; c < 3; c++) {
+			if (CCbigguy_cpu_select(cpus[c])) continue;
+			if (strcmp(CCbigguy_cpu_name(), cpus[c])) bad = 1;
+			got[0] = y[5];
+			gotovf[0] = CCbigguy_addmult_chk(&got[0], y[7], m[7]);
+			got[1] = CCbigguy_MAXBIGGUY;
+			gotovf[1] = CCbigguy_addmult_chk(&got[1], CCbigguy_ONE, 1);
+			{
+				CCbigguy t = y[5], u = y[5];
+				if (CCbigguy_addmult_chk(&t, y[7], 0) || CCbigguy_cmp(t, y[5])) bad = 1;
+				if (CCbigguy_addmult_chk(&t, y[7], -1) != CCbigguy_sub_chk(&u, y[7]) ||
+				    CCbigguy_cmp(t, u)) bad = 1;
+				t = CCbigguy_MINBIGGUY;
+				if (!CCbigguy_addmult_chk(&t, CCbigguy_ONE, -1) ||
+				    CCbigguy_cmp(t, CCbigguy_MINBIGGUY)) bad = 1;
+			}
+			got[2] = CCbigguy_dtobigguy(-0.75);
+			gotovf[2] = CCbigguy_dot_chk(&got[2], y, m, ncpu);
+			got[3] = CCbigguy_ONE;
+			gotovf[3] = CCbigguy_dot_sparse_chk(&got[3], y, ind, m, ncpu);
+			for (int i = 0; i < ncpu; i++) z[i] = CCbigguy_ZERO;
+			gotovf[1] += 2 * CCbigguy_dtobigguy_array(d, z, ncpu);
+			CCbigguy_bigguytod_array(y, dz, ncpu);
+			if (c == 0) {
+				memcpy(want, got, sizeof(want));
+				memcpy(wantovf, gotovf, sizeof(wantovf));
+				continue;
+			}
+			for (int k = 0; k < 4; k++) {
+				if (gotovf[k] != wantovf[k] || CCbigguy_cmp(got[k], want[k])) bad = 1;
+			}
+			for (int i = 1; i < ncpu; i++) {
+				if (dz[i] != CCbigguy_bigguytod(y[i])) bad = 1;
+				if (CCbigguy_cmp(z[i], CCbigguy_dtobigguy(d[i]))) bad = 1;
+			}
+		}
+		if (wantovf[1] != 3 || wantovf[2] || wantovf[3]) bad = 1;
+		if (!CCbigguy_cpu_select("no such cpu")) bad = 1;
+		SAFE(CCbigguy_cpu_select(NULL));
+		if (bad) {
+			printf("per-cpu kernels failed\n");
+		}
+		else
+			printf("PASS per-cpu kernels (%s)\n", CCbigguy_cpu_name());
+		free(y);
+		free(z);
+		free(d);
+		free(dz);
+		free(m);
+		free(ind);
+	}
+
+	{
+		CCbigguy_stats st;
+		CCbigguy a, b;
+		int bad = 0;
+
+		CCbigguy_stats_reset();
+		a = CCbigguy_itobigguy(0);
+		a.fhi = a.flo = BIT_32_UMAX;
+		b = CCbigguy_ZERO;
+		b.flo = 1;
+		CCbigguy_add(&a, b);                    /* carries into ilo */
+		CCbigguy_sub(&a, CCbigguy_itobigguy(2)); /* borrows into ihi */
+		a = CCbigguy_MAXBIGGUY;
+		if (!CCbigguy_add_chk(&a, CCbigguy_ONE)) bad = 1;
+		a = CCbigguy_dtobigguy(2.5);
+		CCbigguy_addmult(&a, CCbigguy_ONE, -1000);
+		a = CCbigguy_ceil(CCbigguy_dtobigguy(0.25));
+		if (CCbigguy_cmp(a, CCbigguy_ONE)) bad = 1;
+		CCbigguy_stats_get(&st);
+#ifdef CC_BIGGUY_STATS
+		if (st.calls[CCbigguy_STAT_ADD] != 2 ||
+		    st.carry[CCbigguy_STAT_ADD][2] != 1 ||
+		    st.carry[CCbigguy_STAT_ADD][CCbigguy_STAT_OVERFLOW] != 1 ||
+		    st.calls[CCbigguy_STAT_SUB] != 1 ||
+		    st.carry[CCbigguy_STAT_SUB][3] != 1 ||
+		    st.calls[CCbigguy_STAT_ADDMULT] != 1 ||
+		    st.carry[CCbigguy_STAT_ADDMULT][3] != 1 ||
+		    st.mult[10] != 1 || st.mhi != 0 ||
+		    st.calls[CCbigguy_STAT_CEIL] != 1 ||
+		    st.carry[CCbigguy_STAT_CEIL][0] != 1 ||
+		    st.calls[CCbigguy_STAT_DTOBIGGUY] != 2 ||
+		    st.calls[CCbigguy_STAT_CMP] != 1) bad = 1;
+		/* 1, -1, 2.5, -997.5, 1/4 and 1 */
+		if (st.mag[65] != 3 || st.mag[66] != 1 || st.mag[74] != 1 ||
+		    st.mag[63] != 1) bad = 1;
+		if (st.frac[0] != 3 || st.frac[1] != 2 || st.frac[2] != 1) bad = 1;
+#else
+		if (st.calls[CCbigguy_STAT_ADD] || st.mag[65]) bad = 1;
+#endif
+		CCbigguy_stats_reset();
+		CCbigguy_stats_get(&st);
+		if (st.calls[CCbigguy_STAT_ADD]) bad = 1;
+		if (bad) {
+			printf("bigguy stats failed\n");
+		}
+		else
+			printf("PASS bigguy stats\n");
+	}
+
+	{
+		CCbigguy a, b, c, w;
+		int bad = 0;
+
+		/* 1.5 * -2.25 = -3.375 exactly, in every mode */
+		for (int r = 0; r < 4; r++) {
+			a = CCbigguy_dtobigguy(1.5);
+			CCbigguy_mul(&a, CCbigguy_dtobigguy(-2.25), r);
+			if (CCbigguy_cmp(a, CCbigguy_dtobigguy(-3.375))) bad = 1;
+		}
+
+		/* 2^-40 * (-2^-30) = -2^-70, and -3 * 2^-64 / 2 */
+		a = CCbigguy_dtobigguy(0x1p-40);
+		b = CCbigguy_dtobigguy(-0x1p-30);
+		w = a;
+		CCbigguy_mul(&w, b, CCbigguy_ROUND_FLOOR);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(-0x1p-64))) bad = 1;
+		w = a;
+		CCbigguy_mul(&w, b, CCbigguy_ROUND_CEIL);
+		if (CCbigguy_cmp(w, CCbigguy_ZERO)) bad = 1;
+		w = a;
+		CCbigguy_mul(&w, b, CCbigguy_ROUND_TRUNC);
+		if (CCbigguy_cmp(w, CCbigguy_ZERO)) bad = 1;
+		w = CCbigguy_dtobigguy(-0x1p-64 * 3);
+		CCbigguy_mul(&w, CCbigguy_dtobigguy(0.5), CCbigguy_ROUND_NEAREST);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(-0x1p-63))) bad = 1;
+
+		/* the sum is rounded once: 2^-64 + 2^-65 rounds to 2^-63 */
+		w = CCbigguy_dtobigguy(0x1p-64);
+		CCbigguy_addmult_bigguy(&w, CCbigguy_dtobigguy(0x1p-33),
+		                        CCbigguy_dtobigguy(0x1p-32),
+		                        CCbigguy_ROUND_NEAREST);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(0x1p-63))) bad = 1;
+
+		/* overflows leave x alone */
+		a = CCbigguy_dtobigguy(0x1p32);
+		w = a;
+		if (!CCbigguy_mul_chk(&w, a, CCbigguy_ROUND_FLOOR)) bad = 1;
+		if (CCbigguy_cmp(w, a)) bad = 1;
+		c = CCbigguy_MAXBIGGUY;
+		if (!CCbigguy_addmult_bigguy_chk(&c, CCbigguy_ONE,
+		        CCbigguy_dtobigguy(0x1p-64), CCbigguy_ROUND_FLOOR)) bad = 1;
+		if (CCbigguy_addmult_bigguy_chk(&c, CCbigguy_ONE,
+		        CCbigguy_dtobigguy(-0x1p-64), CCbigguy_ROUND_FLOOR)) bad = 1;
+		if (!CCbigguy_divint_chk(&c, 0, CCbigguy_ROUND_FLOOR)) bad = 1;
+
+		/* 1/3 and -1/3 */
+		a = CCbigguy_ONE;
+		CCbigguy_divint(&a, 3, CCbigguy_ROUND_FLOOR);
+		b = CCbigguy_ONE;
+		CCbigguy_divint(&b, -3, CCbigguy_ROUND_FLOOR);
+		c = CCbigguy_ZERO;
+		if (!CCbigguy_add_chk(&c, a) && !CCbigguy_add_chk(&c, b) &&
+		    CCbigguy_cmp(c, CCbigguy_dtobigguy(-0x1p-64))) bad = 1;
+		w = a;
+		CCbigguy_addmult(&w, a, 2);
+		c = CCbigguy_ONE;
+		CCbigguy_sub(&c, w);
+		if (CCbigguy_cmp(c, CCbigguy_dtobigguy(0x1p-64))) bad = 1;
+		w = CCbigguy_dtobigguy(-7.0);
+		CCbigguy_divint(&w, 2, CCbigguy_ROUND_TRUNC);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(-3.5))) bad = 1;
+		w = CCbigguy_dtobigguy(0x1p-64 * 5);    /* 2.5 ulps to 2 */
+		CCbigguy_divint(&w, 2, CCbigguy_ROUND_NEAREST);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(0x1p-63))) bad = 1;
+		w = CCbigguy_dtobigguy(0x1p-64 * 7);    /* 3.5 ulps to 4 */
+		CCbigguy_divint(&w, 2, CCbigguy_ROUND_NEAREST);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(0x1p-62))) bad = 1;
+
+		/* x * d, exact and rounded */
+		w = CCbigguy_dtobigguy(3.0);
+		CCbigguy_mul_double(&w, 0.1, CCbigguy_ROUND_FLOOR);
+		a = CCbigguy_dtobigguy(0.1);
+		CCbigguy_addmult(&a, CCbigguy_dtobigguy(0.1), 2);
+		if (CCbigguy_cmp(w, a)) bad = 1;
+		w = CCbigguy_ONE;
+		CCbigguy_mul_double(&w, 0x1p-70, CCbigguy_ROUND_CEIL);
+		if (CCbigguy_cmp(w, CCbigguy_dtobigguy(0x1p-64))) bad = 1;
+		w = CCbigguy_ONE;
+		if (!CCbigguy_mul_double_chk(&w, 0x1p63, CCbigguy_ROUND_FLOOR)) bad = 1;
+		if (CCbigguy_mul_double_chk(&w, -0x1p62, CCbigguy_ROUND_FLOOR)) bad = 1;
+		if (!CCbigguy_mul_double_chk(&w, 0.0 / 0.0, CCbigguy_ROUND_FLOOR)) bad = 1;
+
+		if (bad) {
+			printf("bigguy mul and divint failed\n");
+		}
+		else
+			printf("PASS bigguy mul and divint\n");
+	}
+
+	{
+		/* x += y*m for 64-bit m, checked against the exact bigguy product */
+		static const char *cpus[3] = {"generic", "int128", "int128-bmi2"};
+		long long m[8] = {3LL << 40, -(3LL << 40), 0x7fffffffffffffffLL,
+		                  -0x7fffffffffffffffLL - 1, -12345678901234567LL,
+		                  0x80000000LL, 2, -1};
+		double yd[4] = {0x1.5p-30, -0x1.9e3779b9p-2, 0x1p-64 * 3, 0x1.8p10};
+		CCbigguy x, y, want, got, mb;
+		int bad = 0, ovf, wantovf;
+
+		for (int c = 0; c < 3; c++) {
+			if (CCbigguy_cpu_select(cpus[c])) continue;
+			for (int i = 0; i < 8; i++) {
+				mb.ihi = (unsigned int) ((unsigned long long) m[i] >> 32);
+				mb.ilo = (unsigned int) m[i];
+				mb.fhi = 0;
+				mb.flo = 0;
+				for (int j = 0; j < 4; j++) {
+					y = CCbigguy_dtobigguy(yd[j]);
+					y.flo |= 0x9e3779b9u * (j & 1);
+					x = CCbigguy_dtobigguy(-0.75 * j);
+					want = x;
+					wantovf = CCbigguy_addmult_bigguy_chk(&want, y, mb,
+					                                      CCbigguy_ROUND_FLOOR);
+					got = x;
+					ovf = CCbigguy_addmult_ll_chk(&got, y, m[i]);
+					if (ovf != wantovf || CCbigguy_cmp(got, want)) bad = 1;
+					if (m[i] == (int) m[i]) {
+						got = x;
+						ovf = CCbigguy_addmult_chk(&got, y, (int) m[i]);
+						if (ovf != wantovf || CCbigguy_cmp(got, want)) bad = 1;
+					}
+				}
+			}
+		}
+		SAFE(CCbigguy_cpu_select(NULL));
+
+		/* -2^63 times -1 and times LLONG_MIN */
+		y = CCbigguy_MINBIGGUY;
+		y.flo = 0;
+		x = CCbigguy_ZERO;
+		if (!CCbigguy_addmult_ll_chk(&x, y, -1)) bad = 1;
+		if (!CCbigguy_addmult_ll_chk(&x, y, m[3])) bad = 1;
+		if (CCbigguy_cmp(x, CCbigguy_ZERO)) bad = 1;
+		x = CCbigguy_MAXBIGGUY;
+		CCbigguy_addmult_ll(&x, y, 1);
+		if (CCbigguy_cmp(x, CCbigguy_dtobigguy(-0x1p-64))) bad = 1;
+		x = CCbigguy_MAXBIGGUY;
+		CCbigguy_addmult_ll(&x, CCbigguy_MINBIGGUY, 1);
+		if (CCbigguy_cmp(x, CCbigguy_ZERO)) bad = 1;
+		if (bad) {
+			printf("bigguy addmult_ll failed\n");
+		}
+		else
+			printf("PASS bigguy addmult_ll\n");
+	}
+
+	{
+		/* CCbigguy64 beside CCbigguy128, and the conversions between them */
+		CCbigguy64 s64[4], t64[4], u;
+		CCbigguy128 s128[4], v;
+		int bad = 0;
+
+		s64[0] = CCbigguy64_ONE;
+		CCbigguy64_addmult(&s64[0], CCbigguy64_dtobigguy(0.25), -6);
+		s64[1] = CCbigguy64_MAXBIGGUY;
+		s64[2] = CCbigguy64_MINBIGGUY;
+		s64[3] = CCbigguy64_dtobigguy(-0x1p-32 * 3);
+		if (CCbigguy64_cmp(s64[0], CCbigguy64_dtobigguy(-0.5))) bad = 1;
+		CCbigguy64_to128_array(s64, s128, 4);
+		if (CCbigguy_cmp(s128[0], CCbigguy_dtobigguy(-0.5))) bad = 1;
+		if (CCbigguy_cmp(s128[3], CCbigguy_dtobigguy(-0x1p-32 * 3))) bad = 1;
+		v = CCbigguy64_to128(s64[1]);
+		if (CCbigguy_cmp(v, s128[1]) || CCbigguy_bigguytod(v) != 0x1p31) bad = 1;
+		if (CCbigguy128_to64_array(s128, t64, 4, CCbigguy_ROUND_NEAREST)) bad = 1;
+		for (int i = 0; i < 4; i++) {
+			if (t64[i] != s64[i]) bad = 1;
+		}
+
+		/* 2^-64 steps either side of -3 * 2^-32, in each rounding mode */
+		v = CCbigguy_dtobigguy(-0x1p-32 * 3);
+		CCbigguy_add(&v, CCbigguy_dtobigguy(0x1p-33));
+		u = CCbigguy128_to64(v, CCbigguy_ROUND_FLOOR);
+		if (u != -3) bad = 1;
+		u = CCbigguy128_to64(v, CCbigguy_ROUND_CEIL);
+		if (u != -2) bad = 1;
+		u = CCbigguy128_to64(v, CCbigguy_ROUND_TRUNC);
+		if (u != -2) bad = 1;
+		u = CCbigguy128_to64(v, CCbigguy_ROUND_NEAREST);    /* tie to even */
+		if (u != -2) bad = 1;
+		CCbigguy_add(&v, CCbigguy_dtobigguy(0x1p-64));
+		u = CCbigguy128_to64(v, CCbigguy_ROUND_NEAREST);
+		if (u != -2) bad = 1;
+		CCbigguy_sub(&v, CCbigguy_dtobigguy(0x1p-63));
+		u = CCbigguy128_to64(v, CCbigguy_ROUND_NEAREST);
+		if (u != -3) bad = 1;
+
+		/* narrowing fails, leaving y alone, outside 2^31 */
+		u = 7;
+		if (!CCbigguy128_to64_chk(CCbigguy_dtobigguy(0x1p31), &u,
+		                          CCbigguy_ROUND_FLOOR) || u != 7) bad = 1;
+		v = s128[1];
+		CCbigguy_add(&v, CCbigguy_dtobigguy(0x1p-64));
+		if (CCbigguy128_to64_chk(v, &u, CCbigguy_ROUND_FLOOR) ||
+		    u != CCbigguy64_MAXBIGGUY) bad = 1;
+		if (!CCbigguy128_to64_chk(v, &u, CCbigguy_ROUND_CEIL)) bad = 1;
+		if (!CCbigguy128_to64_chk(CCbigguy_dtobigguy(-0x1p31), &u,
+		                          CCbigguy_ROUND_FLOOR)) bad = 1;
+		s128[2] = CCbigguy_MAXBIGGUY;
+		t64[2] = 5;
+		if (!CCbigguy128_to64_array(s128, t64, 4, CCbigguy_ROUND_FLOOR)) bad = 1;
+		if (t64[2] != 5 || t64[3] != s64[3]) bad = 1;
+		if (bad) {
+			printf("bigguy 64/128 conversions failed\n");
+		}
+		else
+			printf("PASS bigguy 64/128 conversions\n");
+	}
+
+	{
+		/* packed arrays against the plain ones */
+		enum { npk = 1000 };
+		CCbigguy_packed pk;
+		CCbigguy *y, want, got, probe[4];
+		int *m, *cg, bad = 0, wantovf, gotovf;
+
+		y = malloc(sizeof(CCbigguy) * npk);
+		m = malloc(sizeof(int) * npk);
+		cg = malloc(sizeof(int) * npk);
+		SAFE_MALLOC(y);
+		SAFE_MALLOC(m);
+		SAFE_MALLOC(cg);
+		for (int width = 8; width <= 12; width += 4) {
+			SAFE(CCbigguy_packed_init(&pk, npk, width));
+			for (int i = 0; i < npk; i++) {
+				y[i] = CCbigguy_dtobigguy(((i * 7919) % 20011 - 10005) * 0x1.9ep-3);
+				if (width == 12 && i % 3) y[i].flo = 0x9e3779b9u * i;
+				if (i % 97 == 5) y[i] = CCbigguy_dtobigguy(0x1p34 * (i % 2 ? 1 : -1));
+				if (i % 101 == 7) y[i] = CCbigguy_dtobigguy(-0x1p31);
+				m[i] = (i % 5) ? 0x7fffff - i : -0x7fffff + i;
+				SAFE(CCbigguy_packed_set(&pk, i, y[i]));
+			}
+			/* an escaped slot set to a value that fits, and back */
+			SAFE(CCbigguy_packed_set(&pk, 5, CCbigguy_ONE));
+			if (CCbigguy_cmp(CCbigguy_packed_get(&pk, 5), CCbigguy_ONE)) bad = 1;
+			SAFE(CCbigguy_packed_set(&pk, 5, y[5]));
+			for (int i = 0; i < npk; i++) {
+				if (CCbigguy_cmp(CCbigguy_packed_get(&pk, i), y[i])) bad = 1;
+			}
+			if (pk.nesc == 0 || pk.nesc > npk / 40) bad = 1;
+
+			want = CCbigguy_dtobigguy(-0.75);
+			wantovf = 0;
+			for (int i = 0; i < npk; i++) wantovf |= CCbigguy_add_chk(&want, y[i]);
+			got = CCbigguy_dtobigguy(-0.75);
+			gotovf = CCbigguy_packed_sum_chk(&got, &pk);
+			if (gotovf != wantovf || CCbigguy_cmp(got, want)) bad = 1;
+
+			want = CCbigguy_ONE;
+			wantovf = CCbigguy_dot_chk(&want, y, m, npk);
+			got = CCbigguy_ONE;
+			gotovf = CCbigguy_packed_dot_chk(&got, &pk, m);
+			if (gotovf || wantovf || CCbigguy_cmp(got, want)) bad = 1;
+
+			probe[0] = y[10];
+			probe[1] = y[5];
+			probe[2] = CCbigguy_MAXBIGGUY;
+			probe[3] = CCbigguy_dtobigguy(-0x1p31);
+			for (int j = 0; j < 4; j++) {
+				CCbigguy_packed_cmp(&pk, probe[j], cg);
+				for (int i = 0; i < npk; i++) {
+					if (cg[i] != CCbigguy_cmp(y[i], probe[j])) bad = 1;
+				}
+			}
+
+			/* overflow is only tested on the final sum */
+			want = CCbigguy_ONE;
+			for (int i = 4; i < npk; i++) CCbigguy_add(&want, y[i]);
+			SAFE(CCbigguy_packed_set(&pk, 0, CCbigguy_MAXBIGGUY));
+			SAFE(CCbigguy_packed_set(&pk, 1, CCbigguy_MAXBIGGUY));
+			SAFE(CCbigguy_packed_set(&pk, 2, CCbigguy_MINBIGGUY));
+			SAFE(CCbigguy_packed_set(&pk, 3, CCbigguy_MINBIGGUY));
+			got = CCbigguy_ONE;
+			if (CCbigguy_packed_sum_chk(&got, &pk)) bad = 1;
+			if (CCbigguy_cmp(got, want)) bad = 1;
+			SAFE(CCbigguy_packed_set(&pk, 3, CCbigguy_MAXBIGGUY));
+			got = CCbigguy_ONE;
+			if (!CCbigguy_packed_sum_chk(&got, &pk)) bad = 1;
+			if (CCbigguy_cmp(got, CCbigguy_ONE)) bad = 1;
+			CCbigguy_packed_free(&pk);
+		}
+		if (!CCbigguy_packed_init(&pk, 10, 16)) bad = 1;
+		if (!CCbigguy_packed_init(&pk, -1, 8) || pk.mid) bad = 1;
+		if (!CCbigguy_packed_init(&pk, -1, 12) || pk.mid || pk.lo) bad = 1;
+		free(y);
+		free(m);
+		free(cg);
+		if (bad) {
+			printf("bigguy packed arrays failed\n");
+		}
+		else
+			printf("PASS bigguy packed arrays\n");
+	}
+
+	// prefix sums match the serial addmult loop for any pool
+	{
+		enum { nscan = 100003, jump = 60001 };
+		CCbigguy *y = malloc(sizeof(CCbigguy) * nscan);
+		CCbigguy *want = malloc(sizeof(CCbigguy) * nscan);
+		CCbigguy *got = malloc(sizeof(CCbigguy) * nscan);
+		int *m = malloc(sizeof(int) * nscan);
+		CCbigguy_pool *pool;
+		CCbigguy acc, sum;
+		int bad = 0;
+		SAFE_MALLOC(y);
+		SAFE_MALLOC(want);
+		SAFE_MALLOC(got);
+		SAFE_MALLOC(m);
+		for (int i = 0; i < nscan; i++) {
+			y[i] = CCbigguy_dtobigguy(((i * 7919) % 20011 - 10005) * 0x1.9e3779b9p-10);
+			y[i].flo = 0x9e3779b9u * i;
+			m[i] = (i % 3) ? 0x7fffffff - i : -0x7fffffff + i;
+		}
+		for (int t = 0; t <= 4; t += 4) {
+			SAFE(CCbigguy_pool_init(&pool, t ? t : 1));
+
+			/* weighted, inclusive and exclusive */
+			sum = CCbigguy_dtobigguy(0.25);
+			for (int i = 0; i < nscan; i++) {
+				CCbigguy_addmult(&sum, y[i], m[i]);
+				want[i] = sum;
+			}
+			acc = CCbigguy_dtobigguy(0.25);
+			if (CCbigguy_scan_incl_chk(pool, &acc, y, m, nscan, got)) bad = 1;
+			if (CCbigguy_cmp(acc, sum)) bad = 1;
+			for (int i = 0; i < nscan; i++) {
+				if (CCbigguy_cmp(got[i], want[i])) bad = 1;
+			}
+			acc = CCbigguy_dtobigguy(0.25);
+			CCbigguy_scan_excl(pool, &acc, y, m, nscan, got);
+			if (CCbigguy_cmp(acc, sum)) bad = 1;
+			if (CCbigguy_cmp(got[0], CCbigguy_dtobigguy(0.25))) bad = 1;
+			for (int i = 1; i < nscan; i++) {
+				if (CCbigguy_cmp(got[i], want[i - 1])) bad = 1;
+			}
+
+			/* unweighted, in place, with one prefix out of range */
+			sum = CCbigguy_ZERO;
+			for (int i = 0; i < jump; i++) CCbigguy_add(&sum, y[i]);
+			memcpy(got, y, sizeof(CCbigguy) * nscan);
+			got[jump] = (CCbigguy_cmp(sum, CCbigguy_ZERO) > 0) ?
+			            CCbigguy_MAXBIGGUY : CCbigguy_MINBIGGUY;
+			got[jump + 1] = CCbigguy_ZERO;
+			CCbigguy_sub(&got[jump + 1], got[jump]);
+			memcpy(want, got, sizeof(CCbigguy) * nscan);
+			sum = CCbigguy_ZERO;
+			for (int i = 0; i < nscan; i++) {
+				if (i == jump) continue;
+				if (i != jump + 1) CCbigguy_add(&sum, want[i]);
+				want[i] = sum;
+			}
+			acc = CCbigguy_ZERO;
+			if (!CCbigguy_scan_incl_chk(pool, &acc, got, (int *) NULL, nscan,
+			                            got)) bad = 1;
+			if (CCbigguy_cmp(acc, sum)) bad = 1;
+			for (int i = 0; i < nscan; i++) {
+				if (CCbigguy_cmp(got[i], want[i])) bad = 1;
+			}
+
+			/* prefixes past the 1000th and the total do not fit */
+			for (int i = 0; i < nscan; i++) {
+				want[i] = CCbigguy_ONE;
+				got[i] = CCbigguy_ZERO;
+			}
+			acc = CCbigguy_MAXBIGGUY;
+			CCbigguy_addmult(&acc, CCbigguy_ONE, -1000);
+			sum = acc;
+			if (!CCbigguy_scan_incl_chk(pool, &acc, want, (int *) NULL, nscan,
+			                            got)) bad = 1;
+			if (CCbigguy_cmp(acc, sum)) bad = 1;
+			if (CCbigguy_cmp(got[999], CCbigguy_MAXBIGGUY)) bad = 1;
+			if (CCbigguy_cmp(got[1000], CCbigguy_ZERO)) bad = 1;
+			if (CCbigguy_cmp(got[nscan - 1], CCbigguy_ZERO)) bad = 1;
+			CCbigguy_pool_free(pool);
+		}
+		if (bad) {
+			printf("bigguy scan failed\n");
+		}
+		else
+			printf("PASS bigguy scan\n");
+		free(y);
+		free(want);
+		free(got);
+		free(m);
+	}
+
 	free(temp);
 	free(temp1);
 	free(expected);
@@ -0,0 +1,83 @@
+/* Links against the CCbigguy_* names the way objects compiled with the */
+/* older bigguy.h do: the declarations below are that header's, and     */
+/* bigguy.h itself (whose macros turn the names into CCbigguy128_*) is  */
+/* not included.                                                        */
+
+#include <stdio.h>
+#include <string.h>
+#include "machdefs.h"
+#include "util.h"
+
+#if !defined(CC_BIGGUY_LONGLONG) && !defined(CC_BIGGUY_LONG)
+
+typedef struct CCbigguy {
+    unsigned int ihi;
+    unsigned int ilo;
+    unsigned int fhi;
+    unsigned int flo;
+} CCbigguy;
+
+extern const CCbigguy CCbigguy_MINBIGGUY;
+extern const CCbigguy CCbigguy_MAXBIGGUY;
+extern const CCbigguy CCbigguy_ZERO;
+extern const CCbigguy CCbigguy_ONE;
+
+    void
+        CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m);
+
+    int
+        CCbigguy_cmp (CCbigguy x, CCbigguy y);
+
+    double
+        CCbigguy_bigguytod (CCbigguy x);
+
+    CCbigguy
+        CCbigguy_itobigguy (int d),
+        CCbigguy_dtobigguy (double d),
+        CCbigguy_ceil (CCbigguy x);
+
+int
+    CCbigguy_swrite (CC_SFILE *f, CCbigguy x),
+    CCbigguy_sread (CC_SFILE *f, CCbigguy *x);
+
+int main(void) {
+	CCbigguy x, y, back;
+	CC_SFILE *f;
+	int bad = 0;
+
+	if (CCbigguy_MAXBIGGUY.ihi != 0x7fffffff || CCbigguy_MINBIGGUY.flo != 1) bad = 1;
+	if (CCbigguy_ZERO.ilo != 0 || CCbigguy_ONE.ilo != 1) bad = 1;
+
+	x = CCbigguy_dtobigguy(2.75);
+	y = CCbigguy_itobigguy(-3);
+	CCbigguy_addmult(&x, y, 2);
+	if (CCbigguy_bigguytod(x) != -3.25) bad = 1;
+	if (CCbigguy_cmp(x, CCbigguy_ZERO) >= 0) bad = 1;
+	if (CCbigguy_cmp(CCbigguy_ceil(x), CCbigguy_itobigguy(-3)) != 0) bad = 1;
+	if (CCbigguy_cmp(CCbigguy_MINBIGGUY, CCbigguy_MAXBIGGUY) >= 0) bad = 1;
+
+	f = CCutil_sopen("tempfile", "w");
+	if (!f || CCbigguy_swrite(f, x) || CCbigguy_swrite(f, CCbigguy_MINBIGGUY)) bad = 1;
+	if (f) CCutil_sclose(f);
+	f = CCutil_sopen("tempfile", "r");
+	if (!f || CCbigguy_sread(f, &back) || CCbigguy_cmp(back, x)) bad = 1;
+	if (!f || CCbigguy_sread(f, &back) || CCbigguy_cmp(back, CCbigguy_MINBIGGUY)) bad = 1;
+	if (f) CCutil_sclose(f);
+
+	if (bad) {
+		printf("old bigguy link names failed\n");
+	}
+	else
+		printf("PASS old bigguy link names\n");
+	return 0;
+}
+
+#else
+
+// with a builtin CCbigguy the old names were macros, so there is no link
+int main(void) {
+	printf("PASS old bigguy link names\n");
+	return 0;
+}
+
+#endif
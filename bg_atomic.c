@@ -0,0 +1,229 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  SHARED BIGGUY ACCUMULATORS                                              */
+/*                                                                          */
+/*  A CCbigguy_atomic is a CCbigguy that several threads may update at      */
+/*  once.  Where the compiler has a 16-byte compare and swap (on x86-64     */
+/*  gcc and clang need -mcx16), an update reads the value, computes the     */
+/*  new one with the ordinary CCbigguy routines, and swaps it in, trying    */
+/*  again if another thread got there first, so no thread ever blocks.      */
+/*  Otherwise, with CC_POSIXTHREADS, each update holds one of a few         */
+/*  mutexes picked by the address, and without threads the updates are     */
+/*  plain.  An update that would overflow leaves the value as it was.       */
+/*                                                                          */
+/*  When many threads add into one sum, the compare and swap is retried     */
+/*  often; a CCbigguy_wide per thread merged at the end (bg_par.c) is       */
+/*  faster there, and bg_contend measures the difference.                   */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  void CCbigguy_atomic_init (CCbigguy_atomic *a, CCbigguy x)              */
+/*    Sets a to x; no other thread may use a at the same time.              */
+/*                                                                          */
+/*  CCbigguy CCbigguy_atomic_load (CCbigguy_atomic *a)                      */
+/*    Returns the value of a.                                               */
+/*                                                                          */
+/*  int CCbigguy_atomic_addmult_chk (CCbigguy_atomic *a, CCbigguy y,        */
+/*      int m)                                                              */
+/*    a += y*m.  Returns 1 (leaving a unchanged) on overflow, 0 otherwise.  */
+/*                                                                          */
+/*  int CCbigguy_atomic_add_chk (CCbigguy_atomic *a, CCbigguy y)            */
+/*    a += y.  Returns 1 (leaving a unchanged) on overflow, 0 otherwise.    */
+/*                                                                          */
+/*  void CCbigguy_atomic_addmult (CCbigguy_atomic *a, CCbigguy y, int m)    */
+/*  void CCbigguy_atomic_add (CCbigguy_atomic *a, CCbigguy y)               */
+/*    As above, but on overflow an error message is output and the          */
+/*    routine aborts.                                                       */
+/*                                                                          */
+/*  void CCbigguy_atomic_max (CCbigguy_atomic *a, CCbigguy y)               */
+/*    a = max (a, y).                                                       */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16) && defined(__SIZEOF_INT128__)
+#define BIGGUY_ATOMIC_CAS16
+#elif defined(CC_POSIXTHREADS)
+#define BIGGUY_ATOMIC_LOCKS
+#include <pthread.h>
+#endif
+
+#define BIGGUY_ATOMIC_ADD 0
+#define BIGGUY_ATOMIC_MAX 1
+
+#define BIGGUY_ATOMIC_KEEP     1
+#define BIGGUY_ATOMIC_OVERFLOW 2
+
+static int
+    atomic_apply (CCbigguy *x, CCbigguy y, int m, int op),
+    atomic_update (CCbigguy_atomic *a, CCbigguy y, int m, int op);
+
+
+/* x = x op y; returns 0, or BIGGUY_ATOMIC_KEEP if x is not to be */
+/* changed, or BIGGUY_ATOMIC_OVERFLOW                               */
+
+static int atomic_apply (CCbigguy *x, CCbigguy y, int m, int op)
+{
+    if (op == BIGGUY_ATOMIC_MAX) {
+        if (CCbigguy_cmp (y, *x) <= 0) return BIGGUY_ATOMIC_KEEP;
+        *x = y;
+        return 0;
+    }
+    return CCbigguy_addmult_chk (x, y, m) ? BIGGUY_ATOMIC_OVERFLOW : 0;
+}
+
+#ifdef BIGGUY_ATOMIC_CAS16
+
+typedef unsigned __int128 bigguy_atomic_word;
+
+static int atomic_update (CCbigguy_atomic *a, CCbigguy y, int m, int op)
+{
+    bigguy_atomic_word *p = (bigguy_atomic_word *) &a->val;
+    bigguy_atomic_word old, now, new;
+    unsigned long long half[2];
+    CCbigguy x;
+    int r;
+
+    /* the first guess may be torn, so every answer is checked by a swap: */
+    /* one that stores the new value, or, if a is to stay as it is, one    */
+    /* that stores old again; either fails unless old was the value        */
+    half[0] = __atomic_load_n ((unsigned long long *) p, __ATOMIC_RELAXED);
+    half[1] = __atomic_load_n ((unsigned long long *) p + 1,
+                               __ATOMIC_RELAXED);
+    memcpy (&old, half, sizeof (old));
+    for (;;) {
+        memcpy (&x, &old, sizeof (CCbigguy));
+        r = atomic_apply (&x, y, m, op);
+        if (r) {
+            new = old;
+        } else {
+            memcpy (&new, &x, sizeof (CCbigguy));
+        }
+        now = __sync_val_compare_and_swap (p, old, new);
+        if (now == old) break;
+        old = now;
+    }
+    return r == BIGGUY_ATOMIC_OVERFLOW;
+}
+
+CCbigguy CCbigguy_atomic_load (CCbigguy_atomic *a)
+{
+    bigguy_atomic_word v;
+    CCbigguy x;
+
+    /* a swap that fails (or stores the 0 that is there) reads the value */
+    v = __sync_val_compare_and_swap ((bigguy_atomic_word *) &a->val,
+                                     (bigguy_atomic_word) 0,
+                                     (bigguy_atomic_word) 0);
+    memcpy (&x, &v, sizeof (CCbigguy));
+    return x;
+}
+
+#else /* BIGGUY_ATOMIC_CAS16 */
+
+#ifdef BIGGUY_ATOMIC_LOCKS
+
+#define BIGGUY_ATOMIC_NLOCKS 16
+
+static pthread_mutex_t atomic_locks[BIGGUY_ATOMIC_NLOCKS] = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER
+};
+
+#define ATOMIC_LOCK(a) \
+    (&atomic_locks[(((size_t) (a)) >> 4) % BIGGUY_ATOMIC_NLOCKS])
+
+#else
+
+#define ATOMIC_LOCK(a) ((void *) NULL)
+#define pthread_mutex_lock(l)
+#define pthread_mutex_unlock(l)
+
+#endif /* BIGGUY_ATOMIC_LOCKS */
+
+static int atomic_update (CCbigguy_atomic *a, CCbigguy y, int m, int op)
+{
+    CCbigguy x;
+    int r;
+
+    pthread_mutex_lock (ATOMIC_LOCK (a));
+    x = a->val;
+    r = atomic_apply (&x, y, m, op);
+    if (!r) a->val = x;
+    pthread_mutex_unlock (ATOMIC_LOCK (a));
+    return r == BIGGUY_ATOMIC_OVERFLOW;
+}
+
+CCbigguy CCbigguy_atomic_load (CCbigguy_atomic *a)
+{
+    CCbigguy x;
+
+    pthread_mutex_lock (ATOMIC_LOCK (a));
+    x = a->val;
+    pthread_mutex_unlock (ATOMIC_LOCK (a));
+    return x;
+}
+
+#endif /* BIGGUY_ATOMIC_CAS16 */
+
+void CCbigguy_atomic_init (CCbigguy_atomic *a, CCbigguy x)
+{
+    a->val = x;
+}
+
+int CCbigguy_atomic_addmult_chk (CCbigguy_atomic *a, CCbigguy y, int m)
+{
+    return atomic_update (a, y, m, BIGGUY_ATOMIC_ADD);
+}
+
+int CCbigguy_atomic_add_chk (CCbigguy_atomic *a, CCbigguy y)
+{
+    return atomic_update (a, y, 1, BIGGUY_ATOMIC_ADD);
+}
+
+void CCbigguy_atomic_addmult (CCbigguy_atomic *a, CCbigguy y, int m)
+{
+    if (CCbigguy_UNLIKELY (atomic_update (a, y, m, BIGGUY_ATOMIC_ADD))) {
+        CCbigguy_overflow ("CCbigguy_atomic_addmult");
+    }
+}
+
+void CCbigguy_atomic_add (CCbigguy_atomic *a, CCbigguy y)
+{
+    if (CCbigguy_UNLIKELY (atomic_update (a, y, 1, BIGGUY_ATOMIC_ADD))) {
+        CCbigguy_overflow ("CCbigguy_atomic_add");
+    }
+}
+
+void CCbigguy_atomic_max (CCbigguy_atomic *a, CCbigguy y)
+{
+    (void) atomic_update (a, y, 0, BIGGUY_ATOMIC_MAX);
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,696 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  BIGGUY MICROBENCHMARKS                                                  */
+/*                                                                          */
+/*  bg_bench [-c baseline] [-t percent] [-s seconds]                        */
+/*                                                                          */
+/*  Times the bigguy operations on arrays of BENCH_N values, each on two    */
+/*  inputs: "random", values of the size LP duals have (up to 2^40, with    */
+/*  all 64 fraction bits used), and "carry", values picked so that every    */
+/*  add or compare runs through all four limbs (and the conversions hit     */
+/*  their rounding ties).  addmult is timed for multipliers of +-1, below   */
+/*  2^8 and below 2^31.  Each result is the best of BENCH_TRIALS runs of    */
+/*  at least -s seconds of CPU time (default 0.02).  One line is printed    */
+/*  per result,                                                             */
+/*                                                                          */
+/*      bench <op> <input> <impl> <ns per op> <cycles per op>               */
+/*                                                                          */
+/*  where impl is the backend compiled into the library ("portable" or      */
+/*  "int128", with "-inline" for CC_BIGGUY_INLINE) or, for the routines     */
+/*  that bg_cpu.c dispatches, each kernel set this CPU can run.  Cycles     */
+/*  are time stamp counter ticks, or -1 where there is no counter.  Lines   */
+/*  starting with # are comments.                                           */
+/*                                                                          */
+/*  With -c, the results are also compared to those of a file written by    */
+/*  an earlier run; each op, input and impl found in both that is more      */
+/*  than -t percent (default 10) slower is reported, and the exit status    */
+/*  is 1 if there are any.                                                  */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define BENCH_TICKS() ((double) __rdtsc ())
+#else
+#define BENCH_TICKS() (-1.0)
+#endif
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#if defined(CC_BIGGUY_INT128) && defined(__SIZEOF_INT128__)
+#define BENCH_BACKEND "int128"
+#else
+#define BENCH_BACKEND "portable"
+#endif
+
+#ifdef CC_BIGGUY_INLINE
+#define BENCH_BUILD BENCH_BACKEND "-inline"
+#else
+#define BENCH_BUILD BENCH_BACKEND
+#endif
+
+#define BENCH_N        4096
+#define BENCH_IO_N     65536
+#define BENCH_TRIALS   5
+#define BENCH_MAXRES   256
+#define BENCH_TMPFILE  "bg_bench.tmp"
+
+typedef struct bench_result {
+    char op[32];
+    char input[16];
+    char impl[24];
+    double ns;
+    double cycles;
+} bench_result;
+
+static CCbigguy bx[BENCH_N], by[BENCH_N], bw[BENCH_N], bz[BENCH_N];
+static double bd[BENCH_N], be[BENCH_N];
+static int bm[BENCH_N];
+static CCbigguy bio[BENCH_IO_N];
+static int bim[BENCH_IO_N];
+static CCbigguy_packed bpk;
+
+static volatile unsigned int bench_sink;
+static volatile double bench_dsink;
+
+static double bench_mintime = 0.02;
+static bench_result bench_res[BENCH_MAXRES];
+static int bench_nres = 0;
+
+static unsigned int
+    bench_rand (void);
+
+static void
+    bench_random (CCbigguy *x),
+    bench_inputs (int carry, int mrange),
+    bench_run (const char *op, const char *input, const char *impl,
+        int nops, void (*fn) (int reps)),
+    bench_ops (int carry),
+    bench_io (void),
+    usage (char *f);
+
+static int
+    bench_compare (const char *fname, double tol);
+
+
+static unsigned long long bench_state = 0x9e3779b97f4a7c15ULL;
+
+static unsigned int bench_rand (void)
+{
+    bench_state ^= bench_state << 13;
+    bench_state ^= bench_state >> 7;
+    bench_state ^= bench_state << 17;
+    return (unsigned int) (bench_state >> 16);
+}
+
+/* |x| < 2^40, with random fraction bits */
+
+static void bench_random (CCbigguy *x)
+{
+    unsigned int v = bench_rand () & 0xff;
+
+    x->ihi = (bench_rand () & 1) ? BIT_32_UMAX - v : v;
+    x->ilo = bench_rand ();
+    x->fhi = bench_rand ();
+    x->flo = bench_rand ();
+}
+
+/* The carry inputs alternate: x = 2^32 - 2^-64 and y = 1 - 2^-64 carry */
+/* through every limb when added, x = 2^32 and y = 2^-64 borrow through */
+/* every limb when subtracted, and both x have ceilings that carry.     */
+/* w is x with the last bit flipped, for the compares, and z and d are  */
+/* ties for the conversions (2^53 + 1, 2^-11 + 2^-64, and odd           */
+/* multiples of 2^-65).                                                 */
+
+static void bench_inputs (int carry, int mrange)
+{
+    int i;
+
+    for (i = 0; i < BENCH_N; i++) {
+        if (!carry) {
+            bench_random (&bx[i]);
+            bench_random (&by[i]);
+            bw[i] = by[i];
+            bz[i] = bx[i];
+            bd[i] = ((double) (int) bench_rand ()) *
+                    ((double) bench_rand () / 4294967296.0) / 256.0;
+        } else if (i & 1) {
+            bx[i].ihi = 1;
+            bx[i].ilo = bx[i].fhi = bx[i].flo = 0;
+            by[i].ihi = by[i].ilo = by[i].fhi = 0;
+            by[i].flo = 1;
+            bz[i].ihi = bz[i].ilo = 0;
+            bz[i].fhi = 1u << 21;
+            bz[i].flo = 1;
+        } else {
+            bx[i].ihi = 0;
+            bx[i].ilo = bx[i].fhi = bx[i].flo = BIT_32_UMAX;
+            by[i].ihi = by[i].ilo = 0;
+            by[i].fhi = by[i].flo = BIT_32_UMAX;
+            bz[i].ihi = 1u << 21;
+            bz[i].ilo = 1;
+            bz[i].fhi = bz[i].flo = 0;
+        }
+        if (carry) {
+            bw[i] = bx[i];
+            bw[i].flo ^= 1;
+            bd[i] = (double) (2 * i + 1) * 0x1p-65;
+            if (i & 2) bd[i] = -bd[i];
+        }
+        switch (mrange) {
+        case 0:
+            bm[i] = (bench_rand () & 1) ? 1 : -1;
+            break;
+        case 1:
+            bm[i] = (int) (bench_rand () % 511) - 255;
+            break;
+        default:
+            if (carry) bm[i] = (i & 2) ? 0x7fffffff : -0x7fffffff;
+            else {
+                /* keep |y*m| below 2^62 */
+                bm[i] = (int) (bench_rand () >> 1) - 0x3fffffff;
+                by[i].ihi = (by[i].ihi & 0x80000000u) ? BIT_32_UMAX : 0;
+            }
+            break;
+        }
+    }
+}
+
+static void run_add (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = bx[i];
+            CCbigguy_add (&t, by[i]);
+            s += t.flo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_sub (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = bx[i];
+            CCbigguy_sub (&t, by[i]);
+            s += t.flo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_addmult (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = bx[i];
+            CCbigguy_addmult (&t, by[i], bm[i]);
+            s += t.flo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_cmp (int reps)
+{
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            s += (unsigned int) CCbigguy_cmp (bx[i], bw[i]);
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_ceil (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = CCbigguy_ceil (bx[i]);
+            s += t.ilo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_mul (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = bx[i];
+            s += (unsigned int) CCbigguy_mul_chk (&t, by[i],
+                                                  CCbigguy_ROUND_NEAREST);
+            s += t.flo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_divint (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = bx[i];
+            s += (unsigned int) CCbigguy_divint_chk (&t, bm[i] | 1,
+                                                     CCbigguy_ROUND_NEAREST);
+            s += t.flo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_bigguytod (int reps)
+{
+    double s = 0.0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) s += CCbigguy_bigguytod (bz[i]);
+    }
+    bench_dsink = s;
+}
+
+static void run_dtobigguy (int reps)
+{
+    CCbigguy t;
+    unsigned int s = 0;
+    int i;
+
+    while (reps--) {
+        for (i = 0; i < BENCH_N; i++) {
+            t = CCbigguy_dtobigguy (bd[i]);
+            s += t.flo;
+        }
+    }
+    bench_sink = s;
+}
+
+static void run_bigguytod_array (int reps)
+{
+    while (reps--) CCbigguy_bigguytod_array (bz, be, BENCH_N);
+    bench_dsink = be[BENCH_N - 1];
+}
+
+static void run_dtobigguy_array (int reps)
+{
+    int ovf = 0;
+
+    while (reps--) ovf |= CCbigguy_dtobigguy_array (bd, bx, BENCH_N);
+    bench_sink = (unsigned int) ovf + bx[BENCH_N - 1].flo;
+}
+
+static void run_dot (int reps)
+{
+    CCbigguy acc = CCbigguy_ZERO;
+
+    while (reps--) {
+        acc = CCbigguy_ZERO;
+        CCbigguy_dot (&acc, by, bm, BENCH_N);
+    }
+    bench_sink = acc.flo;
+}
+
+static void run_swrite (int reps)
+{
+    CC_SFILE *f;
+
+    while (reps--) {
+        f = CCutil_sopen (BENCH_TMPFILE, "w");
+        if (!f || CCbigguy_swrite_array (f, bio, BENCH_IO_N)) {
+            fprintf (stderr, "could not write %s\n", BENCH_TMPFILE);
+            exit (1);
+        }
+        CCutil_sclose (f);
+    }
+}
+
+static void run_sread (int reps)
+{
+    CC_SFILE *f;
+
+    while (reps--) {
+        f = CCutil_sopen (BENCH_TMPFILE, "r");
+        if (!f || CCbigguy_sread_array (f, bio, BENCH_IO_N)) {
+            fprintf (stderr, "could not read %s\n", BENCH_TMPFILE);
+            exit (1);
+        }
+        CCutil_sclose (f);
+    }
+}
+
+static void run_stream_dot (int reps)
+{
+    CCbigguy acc = CCbigguy_ZERO;
+    int ovf = 0;
+
+    while (reps--) {
+        acc = CCbigguy_ZERO;
+        ovf |= CCbigguy_dot_chk (&acc, bio, bim, BENCH_IO_N);
+    }
+    bench_sink = (unsigned int) ovf + acc.flo;
+}
+
+static void run_packed_dot (int reps)
+{
+    CCbigguy acc = CCbigguy_ZERO;
+    int ovf = 0;
+
+    while (reps--) {
+        acc = CCbigguy_ZERO;
+        ovf |= CCbigguy_packed_dot_chk (&acc, &bpk, bim);
+    }
+    bench_sink = (unsigned int) ovf + acc.flo;
+}
+
+static void run_packed_sum (int reps)
+{
+    CCbigguy acc = CCbigguy_ZERO;
+    int ovf = 0;
+
+    while (reps--) {
+        acc = CCbigguy_ZERO;
+        ovf |= CCbigguy_packed_sum_chk (&acc, &bpk);
+    }
+    bench_sink = (unsigned int) ovf + acc.flo;
+}
+
+static void run_scan_loop (int reps)
+{
+    CCbigguy acc = CCbigguy_ZERO;
+    int i;
+
+    while (reps--) {
+        acc = CCbigguy_ZERO;
+        for (i = 0; i < BENCH_N; i++) {
+            CCbigguy_addmult (&acc, by[i], bm[i]);
+            bw[i] = acc;
+        }
+    }
+    bench_sink = acc.flo + bw[BENCH_N / 2].flo;
+}
+
+static void run_scan (int reps)
+{
+    CCbigguy acc = CCbigguy_ZERO;
+    int ovf = 0;
+
+    while (reps--) {
+        acc = CCbigguy_ZERO;
+        ovf |= CCbigguy_scan_incl_chk ((CCbigguy_pool *) NULL, &acc, by, bm,
+                                       BENCH_N, bw);
+    }
+    bench_sink = (unsigned int) ovf + acc.flo + bw[BENCH_N / 2].flo;
+}
+
+/* times fn, which does nops operations per rep, and records the result */
+
+static void bench_run (const char *op, const char *input, const char *impl,
+        int nops, void (*fn) (int reps))
+{
+    bench_result *r;
+    double t, c, best = -1.0, bestc = -1.0;
+    int reps = 1, k;
+
+    /* find a rep count that takes at least bench_mintime */
+    for (;;) {
+        t = CCutil_zeit ();
+        fn (reps);
+        t = CCutil_zeit () - t;
+        if (t >= bench_mintime || reps >= (1 << 30)) break;
+        reps = (t > bench_mintime / 16) ?
+               (int) (reps * (1.2 * bench_mintime / t)) + 1 : reps * 16;
+    }
+
+    for (k = 0; k < BENCH_TRIALS; k++) {
+        c = BENCH_TICKS ();
+        t = CCutil_zeit ();
+        fn (reps);
+        t = CCutil_zeit () - t;
+        c = BENCH_TICKS () - c;
+        if (best < 0.0 || t < best) {
+            best = t;
+            bestc = c;
+        }
+    }
+
+    if (bench_nres == BENCH_MAXRES) {
+        fprintf (stderr, "too many results\n");
+        exit (1);
+    }
+    r = &bench_res[bench_nres++];
+    sprintf (r->op, "%.31s", op);
+    sprintf (r->input, "%.15s", input);
+    sprintf (r->impl, "%.23s", impl);
+    r->ns = best * 1e9 / ((double) reps * nops);
+    r->cycles = (bestc < 0.0) ? -1.0 : bestc / ((double) reps * nops);
+    printf ("bench %-16s %-6s %-16s %10.3f %10.2f\n", r->op, r->input,
+            r->impl, r->ns, r->cycles);
+    fflush (stdout);
+}
+
+static void bench_ops (int carry)
+{
+    static const char *mname[3] = {"addmult_m1", "addmult_m8",
+                                   "addmult_m31"};
+    const char *input = carry ? "carry" : "random";
+    static const char *cpus[3] = {"generic", "int128", "int128-bmi2"};
+    const char *impl;
+    int mr, c;
+
+    bench_inputs (carry, 2);
+    bench_run ("add", input, BENCH_BUILD, BENCH_N, run_add);
+    bench_run ("sub", input, BENCH_BUILD, BENCH_N, run_sub);
+    bench_run ("cmp", input, BENCH_BUILD, BENCH_N, run_cmp);
+    bench_run ("ceil", input, BENCH_BUILD, BENCH_N, run_ceil);
+    bench_run ("mul", input, BENCH_BACKEND, BENCH_N, run_mul);
+    bench_run ("divint", input, BENCH_BACKEND, BENCH_N, run_divint);
+    bench_run ("bigguytod", input, BENCH_BACKEND, BENCH_N, run_bigguytod);
+    bench_run ("dtobigguy", input, BENCH_BACKEND, BENCH_N, run_dtobigguy);
+
+    for (c = 0; c < 3; c++) {
+        if (CCbigguy_cpu_select (cpus[c])) continue;
+        impl = cpus[c];
+        for (mr = 0; mr < 3; mr++) {
+            bench_inputs (carry, mr);
+#ifdef CC_BIGGUY_INLINE
+            if (c == 0) {
+                bench_run (mname[mr], input, BENCH_BUILD, BENCH_N,
+                           run_addmult);
+            }
+#else
+            bench_run (mname[mr], input, impl, BENCH_N, run_addmult);
+#endif
+        }
+        bench_inputs (carry, 1);
+        bench_run ("dot", input, impl, BENCH_N, run_dot);
+        bench_run ("bigguytod_array", input, impl, BENCH_N,
+                   run_bigguytod_array);
+        bench_inputs (carry, 2);
+        bench_run ("dtobigguy_array", input, impl, BENCH_N,
+                   run_dtobigguy_array);
+    }
+    CCbigguy_cpu_select ((const char *) NULL);
+
+    bench_inputs (carry, 1);
+    bench_run ("scan", input, "loop", BENCH_N, run_scan_loop);
+    bench_run ("scan", input, BENCH_BACKEND, BENCH_N, run_scan);
+}
+
+static void bench_io (void)
+{
+    int i;
+
+    for (i = 0; i < BENCH_IO_N; i++) bench_random (&bio[i]);
+    bench_run ("swrite_array", "random", BENCH_BACKEND, BENCH_IO_N,
+               run_swrite);
+    bench_run ("sread_array", "random", BENCH_BACKEND, BENCH_IO_N,
+               run_sread);
+    remove (BENCH_TMPFILE);
+}
+
+/* streaming dot products over values with 32-bit integer parts, plain */
+/* and packed in 12 and 8 bytes (with about 1% escapes)                */
+
+static void bench_stream (void)
+{
+    static const int width[2] = {12, 8};
+    char impl[24];
+    int i, w;
+
+    for (i = 0; i < BENCH_IO_N; i++) {
+        bench_random (&bio[i]);
+        bio[i].ihi = 0 - (bio[i].ilo >> 31);
+        if (i % 101 == 0) bio[i].ihi ^= 0x40000000;
+        bim[i] = (int) (bench_rand () & 0xff) - 128;
+    }
+    bench_run ("dot_stream", "random", "plain", BENCH_IO_N, run_stream_dot);
+
+    for (w = 0; w < 2; w++) {
+        if (CCbigguy_packed_init (&bpk, BENCH_IO_N, width[w])) {
+            fprintf (stderr, "out of memory\n");
+            exit (1);
+        }
+        for (i = 0; i < BENCH_IO_N; i++) {
+            if (width[w] == 8 && i % 101) bio[i].flo = 0;
+            if (CCbigguy_packed_set (&bpk, i, bio[i])) {
+                fprintf (stderr, "out of memory\n");
+                exit (1);
+            }
+        }
+        sprintf (impl, "packed%d", width[w]);
+        bench_run ("dot_stream", "random", impl, BENCH_IO_N, run_packed_dot);
+        bench_run ("sum_stream", "random", impl, BENCH_IO_N, run_packed_sum);
+        CCbigguy_packed_free (&bpk);
+    }
+}
+
+/* returns the number of regressions, or -1 if fname cannot be read */
+
+static int bench_compare (const char *fname, double tol)
+{
+    FILE *f = fopen (fname, "r");
+    char line[256], op[32], input[16], impl[24];
+    double ns, cyc;
+    int i, nseen = 0, nbad = 0;
+
+    if (!f) {
+        fprintf (stderr, "could not open %s\n", fname);
+        return -1;
+    }
+    while (fgets (line, sizeof (line), f)) {
+        if (sscanf (line, "bench %31s %15s %23s %lf %lf", op, input, impl,
+                    &ns, &cyc) != 5) {
+            continue;
+        }
+        for (i = 0; i < bench_nres; i++) {
+            if (!strcmp (op, bench_res[i].op) &&
+                !strcmp (input, bench_res[i].input) &&
+                !strcmp (impl, bench_res[i].impl)) {
+                break;
+            }
+        }
+        if (i == bench_nres) continue;
+        nseen++;
+        if (bench_res[i].ns > ns * (1.0 + tol / 100.0)) {
+            printf ("# REGRESSION %s %s %s: %.3f ns, was %.3f (+%.1f%%)\n",
+                    op, input, impl, bench_res[i].ns, ns,
+                    100.0 * (bench_res[i].ns / ns - 1.0));
+            nbad++;
+        }
+    }
+    fclose (f);
+    printf ("# compared %d results with %s: %d regressions over %.1f%%\n",
+            nseen, fname, nbad, tol);
+    return nbad;
+}
+
+static void usage (char *f)
+{
+    fprintf (stderr, "usage: %s [-see below-]\n", f);
+    fprintf (stderr, "   -c f  compare with the results in file f\n");
+    fprintf (stderr, "   -t p  report results more than p%% slower (10)\n");
+    fprintf (stderr, "   -s d  time each op for at least d seconds (0.02)\n");
+}
+
+int main (int ac, char **av)
+{
+    char *baseline = (char *) NULL;
+    double tol = 10.0;
+    int c, boptind = 1, nbad = 0;
+    char *boptarg = (char *) NULL;
+
+    while ((c = CCutil_bix_getopt (ac, av, "c:t:s:", &boptind, &boptarg))
+           != EOF) {
+        switch (c) {
+        case 'c':
+            baseline = boptarg;
+            break;
+        case 't':
+            tol = atof (boptarg);
+            break;
+        case 's':
+            bench_mintime = atof (boptarg);
+            break;
+        case CC_BIX_GETOPT_UNKNOWN:
+        case '?':
+        default:
+            usage (av[0]);
+            return 1;
+        }
+    }
+    if (boptind < ac) {
+        usage (av[0]);
+        return 1;
+    }
+
+    printf ("# bigguy benchmarks: %s build, %s kernels by default\n",
+            BENCH_BUILD, CCbigguy_cpu_name ());
+    printf ("# op input impl ns/op cycles/op\n");
+
+    bench_ops (0);
+    bench_ops (1);
+    bench_io ();
+    bench_stream ();
+
+    if (baseline) {
+        nbad = bench_compare (baseline, tol);
+        if (nbad) return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main (void)
+{
+    fprintf (stderr, "bg_bench needs a struct bigguy\n");
+    return 1;
+}
+
+#endif
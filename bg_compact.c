@@ -0,0 +1,246 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  COMPACT BIGGUY STREAMS                                                  */
+/*                                                                          */
+/*  A compact bigguy is written in sign and magnitude form, with the        */
+/*  magnitude split into a 64-bit integer part I and a 64-bit fraction F    */
+/*  (left aligned, so builtin bigguys have 32 zero bits at the bottom).     */
+/*  Sign and magnitude is used rather than a zigzag of the whole value,     */
+/*  since the two's complement of a short negative fraction is long.        */
+/*                                                                          */
+/*    tag byte    bit 0: negative, bit 1: I != 0, bit 2: F != 0,            */
+/*                bits 3-7: s, the fraction is stored shifted right 2s      */
+/*    I           if nonzero, as a base 128 varint, low group first         */
+/*    F >> 2s     if F is nonzero, as a varint                              */
+/*                                                                          */
+/*  Zero is one byte, a small integer two, and 1.5 three (in place of       */
+/*  16).  The decoder reads one value at a time from the stream.            */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_swrite_compact (CC_SFILE *f, CCbigguy x)                   */
+/*  int CCbigguy_sread_compact (CC_SFILE *f, CCbigguy *x)                   */
+/*    Write or read one compact bigguy.  Every CCbigguy, including the      */
+/*    two's complement minimum below CCbigguy_MINBIGGUY, can be written     */
+/*    and read back; sread fails on a malformed or out of range record.     */
+/*                                                                          */
+/*  int CCbigguy_swrite_array_fmt (CC_SFILE *f, const CCbigguy *x, int n,   */
+/*      int fmt)                                                            */
+/*  int CCbigguy_sread_array_fmt (CC_SFILE *f, CCbigguy *x, int n,          */
+/*      int fmt)                                                            */
+/*    Write or read x[0..n-1] as CCbigguy_FMT_FIXED (the format of          */
+/*    CCbigguy_swrite_array) or CCbigguy_FMT_COMPACT (the format of n       */
+/*    calls to CCbigguy_swrite_compact).                                    */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#define COMPACT_MAXBYTES 21    /* tag and two 10 byte varints */
+#define COMPACT_BLOCK 256
+
+static void
+    compact_split (CCbigguy x, int *neg, unsigned long long *ip,
+        unsigned long long *fp);
+
+static int
+    compact_join (int neg, unsigned long long ip, unsigned long long fp,
+        CCbigguy *x),
+    compact_encode (unsigned char *p, CCbigguy x),
+    compact_put_varint (unsigned char *p, unsigned long long v),
+    compact_sread_varint (CC_SFILE *f, unsigned long long *v);
+
+
+#ifdef CC_BIGGUY_BUILTIN
+
+static void compact_split (CCbigguy x, int *neg, unsigned long long *ip,
+        unsigned long long *fp)
+{
+    unsigned long long v = (unsigned long long) x;
+
+    *neg = (x < 0);
+    if (*neg) v = -v;
+    *ip = v >> 32;
+    *fp = v << 32;
+}
+
+static int compact_join (int neg, unsigned long long ip, unsigned long long fp,
+        CCbigguy *x)
+{
+    unsigned long long v;
+
+    /* the magnitude is below 2^63, or equal to it if negative */
+    if ((fp & 0xffffffffULL) ||
+        (ip >> 31 && (!neg || ip != (1ULL << 31) || fp))) {
+        return -1;
+    }
+    v = (ip << 32) | (fp >> 32);
+    if (neg) v = -v;
+    *x = (CCbigguy) v;
+    return 0;
+}
+
+#else  /* CC_BIGGUY_BUILTIN */
+
+static void compact_split (CCbigguy x, int *neg, unsigned long long *ip,
+        unsigned long long *fp)
+{
+    unsigned long long hi = ((unsigned long long) x.ihi << 32) | x.ilo;
+    unsigned long long lo = ((unsigned long long) x.fhi << 32) | x.flo;
+
+    *neg = (int) (x.ihi >> 31);
+    if (*neg) {
+        lo = ~lo + 1;
+        hi = ~hi + (lo == 0);
+    }
+    *ip = hi;
+    *fp = lo;
+}
+
+static int compact_join (int neg, unsigned long long ip, unsigned long long fp,
+        CCbigguy *x)
+{
+    /* the magnitude is at most 2^127, and only if negative */
+    if (ip >> 63 && (!neg || ip << 1 || fp)) return -1;
+    if (neg) {
+        fp = ~fp + 1;
+        ip = ~ip + (fp == 0);
+    }
+    x->ihi = (unsigned int) (ip >> 32);
+    x->ilo = (unsigned int) ip;
+    x->fhi = (unsigned int) (fp >> 32);
+    x->flo = (unsigned int) fp;
+    return 0;
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
+
+static int compact_put_varint (unsigned char *p, unsigned long long v)
+{
+    int k = 0;
+
+    while (v >= 0x80) {
+        p[k++] = (unsigned char) (v | 0x80);
+        v >>= 7;
+    }
+    p[k++] = (unsigned char) v;
+    return k;
+}
+
+static int compact_encode (unsigned char *p, CCbigguy x)
+{
+    unsigned long long ip, fp;
+    int neg, s = 0, k = 1;
+
+    compact_split (x, &neg, &ip, &fp);
+    p[0] = (unsigned char) neg;
+    if (ip) {
+        p[0] |= 2;
+        k += compact_put_varint (p + k, ip);
+    }
+    if (fp) {
+#ifdef __GNUC__
+        s = __builtin_ctzll (fp) / 2;
+#else
+        while (!((fp >> (2 * s)) & 3)) s++;
+#endif
+        p[0] |= (unsigned char) (4 | (s << 3));
+        k += compact_put_varint (p + k, fp >> (2 * s));
+    }
+    return k;
+}
+
+static int compact_sread_varint (CC_SFILE *f, unsigned long long *v)
+{
+    unsigned char c;
+    int shift = 0;
+
+    *v = 0;
+    do {
+        if (CCutil_sread_uchar (f, &c)) return -1;
+        if (shift == 63 && (c & 0x7e)) return -1;
+        *v |= (unsigned long long) (c & 0x7f) << shift;
+        shift += 7;
+    } while ((c & 0x80) && shift < 64);
+
+    return (c & 0x80) ? -1 : 0;
+}
+
+int CCbigguy_swrite_compact (CC_SFILE *f, CCbigguy x)
+{
+    unsigned char buf[COMPACT_MAXBYTES];
+    int k = compact_encode (buf, x);
+
+    return CCutil_swrite (f, (char *) buf, k) ? -1 : 0;
+}
+
+int CCbigguy_sread_compact (CC_SFILE *f, CCbigguy *x)
+{
+    unsigned char tag;
+    unsigned long long ip = 0, fp = 0;
+    int s;
+
+    if (CCutil_sread_uchar (f, &tag)) return -1;
+    if ((tag & 2) && compact_sread_varint (f, &ip)) return -1;
+    if (tag & 4) {
+        if (compact_sread_varint (f, &fp)) return -1;
+        s = 2 * (tag >> 3);
+        if (s && (fp >> (64 - s))) return -1;
+        fp <<= s;
+    } else if (tag >> 3) {
+        return -1;
+    }
+    return compact_join (tag & 1, ip, fp, x);
+}
+
+int CCbigguy_swrite_array_fmt (CC_SFILE *f, const CCbigguy *x, int n, int fmt)
+{
+    unsigned char buf[COMPACT_BLOCK * COMPACT_MAXBYTES];
+    int i, k, len;
+
+    if (fmt == CCbigguy_FMT_FIXED) {
+        return CCbigguy_swrite_array (f, x, n);
+    }
+
+    while (n > 0) {
+        k = (n < COMPACT_BLOCK) ? n : COMPACT_BLOCK;
+        for (i = 0, len = 0; i < k; i++) {
+            len += compact_encode (buf + len, x[i]);
+        }
+        if (CCutil_swrite (f, (char *) buf, len)) return -1;
+        x += k;
+        n -= k;
+    }
+    return 0;
+}
+
+int CCbigguy_sread_array_fmt (CC_SFILE *f, CCbigguy *x, int n, int fmt)
+{
+    int i;
+
+    if (fmt == CCbigguy_FMT_FIXED) {
+        return CCbigguy_sread_array (f, x, n);
+    }
+
+    for (i = 0; i < n; i++) {
+        if (CCbigguy_sread_compact (f, &x[i])) return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,252 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+
+/****************************************************************************/
+/*                                                                          */
+/*  THE CCbigguy_* LINK NAMES                                               */
+/*                                                                          */
+/*  bigguy.h maps the CCbigguy_* names to the CCbigguy128_* routines with   */
+/*  macros, so code compiled against it never refers to CCbigguy_*.         */
+/*  Objects compiled against the older bigguy.h, where CCbigguy was the     */
+/*  struct and the routines were called CCbigguy_*, still do; this file     */
+/*  defines those symbols (the four constants again, and the functions as   */
+/*  calls of their CCbigguy128_* forms) so that they keep linking.  It is   */
+/*  empty when the library is built with CCbigguy a CCbigguy64, since the   */
+/*  CCbigguy_* names were macros then.                                      */
+/*                                                                          */
+/*  The functions are CCbigguy_add, _sub, _addmult, _addmult_ll, _add_chk,  */
+/*  _sub_chk, _addmult_chk, _addmult_ll_chk, _cmp, _ceil, _ceil_chk,        */
+/*  _bigguytod, _itobigguy, _dtobigguy, _dtobigguy_chk, _dot, _dot_sparse,  */
+/*  _dot_chk, _dot_sparse_chk, _dtobigguy_array, _bigguytod_array,          */
+/*  _swrite, _sread, _swrite_array and _sread_array, documented in          */
+/*  bigguy.c and bg_wide.c under those names.                               */
+/*                                                                          */
+/****************************************************************************/
+
+/* CCbigguy_add etc. are object-like macros unless CC_BIGGUY_INLINE makes */
+/* them the inline routines; here they must be plain names                */
+#undef CC_BIGGUY_INLINE
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#undef CCbigguy_MAXBIGGUY
+#undef CCbigguy_MINBIGGUY
+#undef CCbigguy_ZERO
+#undef CCbigguy_ONE
+#undef CCbigguy_add
+#undef CCbigguy_sub
+#undef CCbigguy_addmult
+#undef CCbigguy_addmult_ll
+#undef CCbigguy_add_chk
+#undef CCbigguy_sub_chk
+#undef CCbigguy_addmult_chk
+#undef CCbigguy_addmult_ll_chk
+#undef CCbigguy_cmp
+#undef CCbigguy_ceil
+#undef CCbigguy_ceil_chk
+#undef CCbigguy_bigguytod
+#undef CCbigguy_itobigguy
+#undef CCbigguy_dtobigguy
+#undef CCbigguy_dtobigguy_chk
+#undef CCbigguy_dot
+#undef CCbigguy_dot_sparse
+#undef CCbigguy_dot_chk
+#undef CCbigguy_dot_sparse_chk
+#undef CCbigguy_dtobigguy_array
+#undef CCbigguy_bigguytod_array
+#undef CCbigguy_swrite
+#undef CCbigguy_sread
+#undef CCbigguy_swrite_array
+#undef CCbigguy_sread_array
+
+extern const CCbigguy CCbigguy_MINBIGGUY;
+extern const CCbigguy CCbigguy_MAXBIGGUY;
+extern const CCbigguy CCbigguy_ZERO;
+extern const CCbigguy CCbigguy_ONE;
+
+    void
+        CCbigguy_add (CCbigguy *x, CCbigguy y),
+        CCbigguy_sub (CCbigguy *x, CCbigguy y),
+        CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m),
+        CCbigguy_addmult_ll (CCbigguy *x, CCbigguy y, long long m),
+        CCbigguy_dot (CCbigguy *acc, const CCbigguy *y, const int *m, int n),
+        CCbigguy_dot_sparse (CCbigguy *acc, const CCbigguy *y, const int *ind,
+            const int *m, int n),
+        CCbigguy_bigguytod_array (const CCbigguy *x, double *d, int n);
+
+    int
+        CCbigguy_add_chk (CCbigguy *x, CCbigguy y),
+        CCbigguy_sub_chk (CCbigguy *x, CCbigguy y),
+        CCbigguy_addmult_chk (CCbigguy *x, CCbigguy y, int m),
+        CCbigguy_addmult_ll_chk (CCbigguy *x, CCbigguy y, long long m),
+        CCbigguy_cmp (CCbigguy x, CCbigguy y),
+        CCbigguy_ceil_chk (CCbigguy *x),
+        CCbigguy_dtobigguy_chk (double d, CCbigguy *x),
+        CCbigguy_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *m,
+            int n),
+        CCbigguy_dot_sparse_chk (CCbigguy *acc, const CCbigguy *y,
+            const int *ind, const int *m, int n),
+        CCbigguy_dtobigguy_array (const double *d, CCbigguy *x, int n),
+        CCbigguy_swrite (CC_SFILE *f, CCbigguy x),
+        CCbigguy_sread (CC_SFILE *f, CCbigguy *x),
+        CCbigguy_swrite_array (CC_SFILE *f, const CCbigguy *x, int n),
+        CCbigguy_sread_array (CC_SFILE *f, CCbigguy *x, int n);
+
+    CCbigguy
+        CCbigguy_ceil (CCbigguy x),
+        CCbigguy_itobigguy (int d),
+        CCbigguy_dtobigguy (double d);
+
+    double
+        CCbigguy_bigguytod (CCbigguy x);
+
+const CCbigguy CCbigguy_MINBIGGUY = {0x80000000,0x00000000,0x00000000,0x00000001};
+const CCbigguy CCbigguy_MAXBIGGUY = {0x7fffffff,0xffffffff,0xffffffff,0xffffffff};
+const CCbigguy CCbigguy_ZERO = {0,0,0,0};
+const CCbigguy CCbigguy_ONE = {0,1,0,0};
+
+void CCbigguy_add (CCbigguy *x, CCbigguy y)
+{
+    CCbigguy128_add (x, y);
+}
+
+void CCbigguy_sub (CCbigguy *x, CCbigguy y)
+{
+    CCbigguy128_sub (x, y);
+}
+
+void CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m)
+{
+    CCbigguy128_addmult (x, y, m);
+}
+
+void CCbigguy_addmult_ll (CCbigguy *x, CCbigguy y, long long m)
+{
+    CCbigguy128_addmult_ll (x, y, m);
+}
+
+int CCbigguy_add_chk (CCbigguy *x, CCbigguy y)
+{
+    return CCbigguy128_add_chk (x, y);
+}
+
+int CCbigguy_sub_chk (CCbigguy *x, CCbigguy y)
+{
+    return CCbigguy128_sub_chk (x, y);
+}
+
+int CCbigguy_addmult_chk (CCbigguy *x, CCbigguy y, int m)
+{
+    return CCbigguy128_addmult_chk (x, y, m);
+}
+
+int CCbigguy_addmult_ll_chk (CCbigguy *x, CCbigguy y, long long m)
+{
+    return CCbigguy128_addmult_ll_chk (x, y, m);
+}
+
+int CCbigguy_cmp (CCbigguy x, CCbigguy y)
+{
+    return CCbigguy128_cmp (x, y);
+}
+
+CCbigguy CCbigguy_ceil (CCbigguy x)
+{
+    return CCbigguy128_ceil (x);
+}
+
+int CCbigguy_ceil_chk (CCbigguy *x)
+{
+    return CCbigguy128_ceil_chk (x);
+}
+
+double CCbigguy_bigguytod (CCbigguy x)
+{
+    return CCbigguy128_bigguytod (x);
+}
+
+CCbigguy CCbigguy_itobigguy (int d)
+{
+    return CCbigguy128_itobigguy (d);
+}
+
+CCbigguy CCbigguy_dtobigguy (double d)
+{
+    return CCbigguy128_dtobigguy (d);
+}
+
+int CCbigguy_dtobigguy_chk (double d, CCbigguy *x)
+{
+    return CCbigguy128_dtobigguy_chk (d, x);
+}
+
+void CCbigguy_dot (CCbigguy *acc, const CCbigguy *y, const int *m, int n)
+{
+    CCbigguy128_dot (acc, y, m, n);
+}
+
+void CCbigguy_dot_sparse (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    CCbigguy128_dot_sparse (acc, y, ind, m, n);
+}
+
+int CCbigguy_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *m, int n)
+{
+    return CCbigguy128_dot_chk (acc, y, m, n);
+}
+
+int CCbigguy_dot_sparse_chk (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    return CCbigguy128_dot_sparse_chk (acc, y, ind, m, n);
+}
+
+int CCbigguy_dtobigguy_array (const double *d, CCbigguy *x, int n)
+{
+    return CCbigguy128_dtobigguy_array (d, x, n);
+}
+
+void CCbigguy_bigguytod_array (const CCbigguy *x, double *d, int n)
+{
+    CCbigguy128_bigguytod_array (x, d, n);
+}
+
+int CCbigguy_swrite (CC_SFILE *f, CCbigguy x)
+{
+    return CCbigguy128_swrite (f, x);
+}
+
+int CCbigguy_sread (CC_SFILE *f, CCbigguy *x)
+{
+    return CCbigguy128_sread (f, x);
+}
+
+int CCbigguy_swrite_array (CC_SFILE *f, const CCbigguy *x, int n)
+{
+    return CCbigguy128_swrite_array (f, x, n);
+}
+
+int CCbigguy_sread_array (CC_SFILE *f, CCbigguy *x, int n)
+{
+    return CCbigguy128_sread_array (f, x, n);
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,171 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  CONTENTION BENCHMARK FOR SHARED BIGGUY ACCUMULATORS                     */
+/*                                                                          */
+/*  bg_contend [nthreads] [nops]                                            */
+/*                                                                          */
+/*  Each of nthreads threads adds nops products y*m into one shared sum,    */
+/*  three ways: through a CCbigguy_atomic, through a CCbigguy guarded by a  */
+/*  pthread mutex, and into a CCbigguy_wide per thread (on its own cache    */
+/*  line) that are merged at the end.  For each it prints a line            */
+/*                                                                          */
+/*      contend <method> <nthreads> <ns per op>                             */
+/*                                                                          */
+/*  and it checks that the three sums agree.  Needs CC_POSIXTHREADS.        */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#if defined(CC_POSIXTHREADS) && !defined(CC_BIGGUY_BUILTIN)
+
+#include <pthread.h>
+
+#define CONTEND_NY 61
+#define CONTEND_MAXTHREADS 256
+
+typedef union contend_shard {
+    CCbigguy_wide w;
+    char line[128];
+} contend_shard;
+
+typedef struct contend_arg {
+    int id;
+    int nops;
+    int method;
+} contend_arg;
+
+static CCbigguy contend_y[CONTEND_NY];
+static CCbigguy_atomic contend_atomic;
+static CCbigguy contend_locked;
+static pthread_mutex_t contend_lock = PTHREAD_MUTEX_INITIALIZER;
+static contend_shard contend_shards[CONTEND_MAXTHREADS];
+
+static void
+    *contend_run (void *arg);
+
+static double
+    contend_time (int method, int nthreads, int nops);
+
+
+static void *contend_run (void *arg)
+{
+    contend_arg *a = (contend_arg *) arg;
+    CCbigguy_wide *w = &contend_shards[a->id].w;
+    int k, m;
+
+    for (k = 0; k < a->nops; k++) {
+        m = (k & 1023) - 511;
+        switch (a->method) {
+        case 0:
+            CCbigguy_atomic_addmult (&contend_atomic,
+                                     contend_y[(k + a->id) % CONTEND_NY], m);
+            break;
+        case 1:
+            pthread_mutex_lock (&contend_lock);
+            CCbigguy_addmult (&contend_locked,
+                              contend_y[(k + a->id) % CONTEND_NY], m);
+            pthread_mutex_unlock (&contend_lock);
+            break;
+        default:
+            CCbigguy_wide_addmult (w, &contend_y[(k + a->id) % CONTEND_NY],
+                                   m);
+            break;
+        }
+    }
+    return (void *) NULL;
+}
+
+static double contend_time (int method, int nthreads, int nops)
+{
+    pthread_t th[CONTEND_MAXTHREADS];
+    contend_arg args[CONTEND_MAXTHREADS];
+    double t;
+    int i;
+
+    t = CCutil_real_zeit ();
+    for (i = 0; i < nthreads; i++) {
+        args[i].id = i;
+        args[i].nops = nops;
+        args[i].method = method;
+        if (pthread_create (&th[i], (pthread_attr_t *) NULL, contend_run,
+                            &args[i])) {
+            fprintf (stderr, "pthread_create failed\n");
+            exit (1);
+        }
+    }
+    for (i = 0; i < nthreads; i++) pthread_join (th[i], (void **) NULL);
+    t = CCutil_real_zeit () - t;
+    return t * 1e9 / ((double) nthreads * nops);
+}
+
+int main (int ac, char **av)
+{
+    static const char *name[3] = {"atomic", "mutex", "sharded"};
+    int nthreads = (ac > 1) ? atoi (av[1]) : 4;
+    int nops = (ac > 2) ? atoi (av[2]) : 1000000;
+    CCbigguy_wide w;
+    CCbigguy sum[3];
+    int i, method;
+
+    if (nthreads < 1 || nthreads > CONTEND_MAXTHREADS || nops < 1) {
+        fprintf (stderr, "usage: %s [nthreads] [nops]\n", av[0]);
+        return 1;
+    }
+    for (i = 0; i < CONTEND_NY; i++) {
+        contend_y[i] = CCbigguy_dtobigguy ((i - 30) * 0x1.6a09e667f3bcdp11);
+        contend_y[i].flo = 0x6a09e667u * i;
+    }
+
+    CCbigguy_atomic_init (&contend_atomic, CCbigguy_ZERO);
+    contend_locked = CCbigguy_ZERO;
+    for (i = 0; i < nthreads; i++) {
+        CCbigguy_wide_init (&contend_shards[i].w, CCbigguy_ZERO);
+    }
+
+    for (method = 0; method < 3; method++) {
+        printf ("contend %s %d %.2f\n", name[method], nthreads,
+                contend_time (method, nthreads, nops));
+        fflush (stdout);
+    }
+
+    sum[0] = CCbigguy_atomic_load (&contend_atomic);
+    sum[1] = contend_locked;
+    CCbigguy_wide_init (&w, CCbigguy_ZERO);
+    for (i = 0; i < nthreads; i++) {
+        CCbigguy_wide_merge (&w, &contend_shards[i].w);
+    }
+    if (CCbigguy_wide_narrow (&w, &sum[2]) ||
+        CCbigguy_cmp (sum[0], sum[1]) || CCbigguy_cmp (sum[0], sum[2])) {
+        fprintf (stderr, "the sums do not agree\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main (void)
+{
+    fprintf (stderr, "bg_contend needs CC_POSIXTHREADS and a struct bigguy\n");
+    return 1;
+}
+
+#endif
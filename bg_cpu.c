@@ -0,0 +1,434 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  PER-CPU BIGGUY KERNELS                                                  */
+/*                                                                          */
+/*  CCbigguy_addmult, the dot products and the array conversions are        */
+/*  compiled more than once, and one version is chosen when the program     */
+/*  starts (or on the first call, for compilers without constructors):      */
+/*                                                                          */
+/*    "generic"  the routines of the bigguy.c backend, with the 32-bit      */
+/*               limb CCbigguy_wide for the dot products;                   */
+/*    "int128"   64-bit limbs with 128-bit products, wherever the           */
+/*               compiler has __int128; a dot product term is two           */
+/*               multiplies and four adds;                                  */
+/*    "int128-bmi2"  the same C int128 kernels compiled for x86-64 with    */
+/*               BMI1, BMI2 and LZCNT enabled (so the multiplies become     */
+/*               mulx), used if CPUID reports all three.                    */
+/*                                                                          */
+/*  The last one that the CPU can run is chosen, unless the environment     */
+/*  variable CC_BIGGUY_CPU names another (for testing; "auto" is the        */
+/*  default choice).  All versions give the same bits.                     */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_cpu_select (const char *name)                              */
+/*    Uses the kernels called name from now on, or the fastest that this    */
+/*    CPU can run if name is NULL or "auto".  Returns 1 (changing           */
+/*    nothing) if there are no such kernels or this CPU cannot run them,    */
+/*    and 0 otherwise.  No other thread may be using bigguys meanwhile.     */
+/*                                                                          */
+/*  const char *CCbigguy_cpu_name (void)                                    */
+/*    The name of the kernels in use.                                       */
+/*                                                                          */
+/*  The entry points built here (CCbigguy_addmult, CCbigguy_addmult_chk,    */
+/*  CCbigguy_addmult_ll, CCbigguy_addmult_ll_chk, CCbigguy_dot_chk,         */
+/*  CCbigguy_dot_sparse_chk, CCbigguy_dtobigguy_array and                  */
+/*  CCbigguy_bigguytod_array) are documented in bigguy.c and bg_wide.c.     */
+/*  With CC_BIGGUY_INLINE, callers of CCbigguy_addmult inline the bigguy.c  */
+/*  backend instead.                                                        */
+/*                                                                          */
+/****************************************************************************/
+
+/* the exported symbols are always built, whatever CC_BIGGUY_INLINE says, */
+/* and CCbigguy is CCbigguy128 here whatever CC_BIGGUY_LONGLONG says       */
+#undef CC_BIGGUY_INLINE
+#undef CC_BIGGUY_LONGLONG
+#undef CC_BIGGUY_LONG
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+#include "bg_inline.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#ifdef __SIZEOF_INT128__
+#define BIGGUY_CPU_INT128
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BIGGUY_CPU_BMI2
+#include <cpuid.h>
+#define BIGGUY_CPU_BMI2_TARGET __attribute__ ((target ("bmi,bmi2,lzcnt")))
+#endif
+#endif
+
+typedef struct bigguy_kernels {
+    const char *name;
+    int (*usable) (void);
+    int (*addmult_chk) (CCbigguy *x, CCbigguy y, long long m);
+    int (*dot_chk) (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n);
+    int (*dtobigguy_array) (const double *d, CCbigguy *x, int n);
+    void (*bigguytod_array) (const CCbigguy *x, double *d, int n);
+} bigguy_kernels;
+
+static void
+    cpu_start (void);
+
+static int
+    cpu_always (void);
+
+
+static int cpu_always (void)
+{
+    return 1;
+}
+
+/* the generic kernels */
+
+static int generic_addmult_chk (CCbigguy *x, CCbigguy y, long long m)
+{
+    return CCbigguy_inline_addmult_ll_chk (x, y, m);
+}
+
+static int generic_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    CCbigguy_wide w;
+
+    CCbigguy_wide_init (&w, *acc);
+    if (ind) CCbigguy_wide_dot_sparse (&w, y, ind, m, n);
+    else     CCbigguy_wide_dot (&w, y, m, n);
+    return CCbigguy_wide_narrow (&w, acc);
+}
+
+static inline int dtobigguy_array (const double *d, CCbigguy *x, int n)
+{
+    int i, ovf = 0;
+
+    for (i = 0; i < n; i++) {
+        ovf |= CCbigguy_inline_dtobigguy_chk (d[i], &x[i]);
+    }
+    return ovf;
+}
+
+static inline void bigguytod_array (const CCbigguy *x, double *d, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++) d[i] = CCbigguy_inline_bigguytod (x[i]);
+}
+
+static int generic_dtobigguy_array (const double *d, CCbigguy *x, int n)
+{
+    return dtobigguy_array (d, x, n);
+}
+
+static void generic_bigguytod_array (const CCbigguy *x, double *d, int n)
+{
+    bigguytod_array (x, d, n);
+}
+
+#ifdef BIGGUY_CPU_INT128
+
+/* The 64-bit limb kernels view x as hi * 2^64 + lo, with hi signed and   */
+/* lo unsigned.  A term y*m adds LO(y)*m to a 128-bit lo sum and          */
+/* HI(y)*m to a 128-bit hi sum; each is below 2^95 in magnitude, so lo    */
+/* is folded into hi only every BIGGUY_CPU_FOLD terms.  addmult_64 takes  */
+/* a 64-bit m: its products are then below 2^127, and one term fits.      */
+/* Like CCbigguy_addmult_ll_chk, it sends m = 0, 1 and -1 to the adds.    */
+
+typedef __int128 bigguy_i128;
+
+#define BIGGUY_CPU_FOLD (1 << 30)
+
+#define LIMB_HI(x) ((long long) (((unsigned long long) (x).ihi << 32) |    \
+                                 (unsigned long long) (x).ilo))
+#define LIMB_LO(x) (((unsigned long long) (x).fhi << 32) |                  \
+                    (unsigned long long) (x).flo)
+
+static inline int addmult_64 (CCbigguy *x, CCbigguy y, long long m)
+{
+    bigguy_i128 lo, hi;
+
+    if (m == 1) {
+        return CCbigguy_inline_add_chk (x, y);
+    } else if (m == -1) {
+        return CCbigguy_inline_sub_chk (x, y);
+    } else if (m == 0) {
+        return 0;
+    }
+
+    lo = (bigguy_i128) LIMB_LO(*x) + (bigguy_i128) LIMB_LO(y) * m;
+    hi = (bigguy_i128) LIMB_HI(*x) + (bigguy_i128) LIMB_HI(y) * m + (lo >> 64);
+    if (CCbigguy_UNLIKELY (hi != (long long) hi)) return 1;
+
+    x->ihi = (unsigned int) ((unsigned long long) hi >> 32);
+    x->ilo = (unsigned int) hi;
+    x->fhi = (unsigned int) ((unsigned long long) lo >> 32);
+    x->flo = (unsigned int) lo;
+    return 0;
+}
+
+static inline int dot_64 (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    bigguy_i128 lo = (bigguy_i128) LIMB_LO(*acc);
+    bigguy_i128 hi = (bigguy_i128) LIMB_HI(*acc);
+    int i, k, stop;
+
+    for (i = 0; i < n; i = stop) {
+        stop = (n - i > BIGGUY_CPU_FOLD) ? i + BIGGUY_CPU_FOLD : n;
+        if (ind) {
+            for (k = i; k < stop; k++) {
+                lo += (bigguy_i128) LIMB_LO(y[ind[k]]) * m[k];
+                hi += (bigguy_i128) LIMB_HI(y[ind[k]]) * m[k];
+            }
+        } else {
+            for (k = i; k < stop; k++) {
+                lo += (bigguy_i128) LIMB_LO(y[k]) * m[k];
+                hi += (bigguy_i128) LIMB_HI(y[k]) * m[k];
+            }
+        }
+        hi += lo >> 64;
+        lo = (unsigned long long) lo;
+    }
+    if (hi != (long long) hi) return 1;
+
+    acc->ihi = (unsigned int) ((unsigned long long) hi >> 32);
+    acc->ilo = (unsigned int) hi;
+    acc->fhi = (unsigned int) ((unsigned long long) lo >> 32);
+    acc->flo = (unsigned int) lo;
+    return 0;
+}
+
+static int int128_addmult_chk (CCbigguy *x, CCbigguy y, long long m)
+{
+    return addmult_64 (x, y, m);
+}
+
+static int int128_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    return dot_64 (acc, y, ind, m, n);
+}
+
+#endif /* BIGGUY_CPU_INT128 */
+
+#ifdef BIGGUY_CPU_BMI2
+
+static int bmi2_usable (void)
+{
+    unsigned int a, b, c, d;
+
+    if (!__get_cpuid (0x80000001, &a, &b, &c, &d)) return 0;
+    if (!(c & (1u << 5))) return 0;                         /* LZCNT */
+    if (__get_cpuid_max (0, (unsigned int *) NULL) < 7) return 0;
+    __cpuid_count (7, 0, a, b, c, d);
+    return (b & (1u << 3)) && (b & (1u << 8));              /* BMI1, BMI2 */
+}
+
+BIGGUY_CPU_BMI2_TARGET
+static int bmi2_addmult_chk (CCbigguy *x, CCbigguy y, long long m)
+{
+    return addmult_64 (x, y, m);
+}
+
+BIGGUY_CPU_BMI2_TARGET
+static int bmi2_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    return dot_64 (acc, y, ind, m, n);
+}
+
+BIGGUY_CPU_BMI2_TARGET
+static int bmi2_dtobigguy_array (const double *d, CCbigguy *x, int n)
+{
+    return dtobigguy_array (d, x, n);
+}
+
+BIGGUY_CPU_BMI2_TARGET
+static void bmi2_bigguytod_array (const CCbigguy *x, double *d, int n)
+{
+    bigguytod_array (x, d, n);
+}
+
+#endif /* BIGGUY_CPU_BMI2 */
+
+/* slowest first */
+
+static const bigguy_kernels bigguy_cpu_kernels[] = {
+    {"generic", cpu_always, generic_addmult_chk, generic_dot_chk,
+     generic_dtobigguy_array, generic_bigguytod_array},
+#ifdef BIGGUY_CPU_INT128
+    {"int128", cpu_always, int128_addmult_chk, int128_dot_chk,
+     generic_dtobigguy_array, generic_bigguytod_array},
+#endif
+#ifdef BIGGUY_CPU_BMI2
+    {"int128-bmi2", bmi2_usable, bmi2_addmult_chk, bmi2_dot_chk,
+     bmi2_dtobigguy_array, bmi2_bigguytod_array},
+#endif
+};
+
+#define BIGGUY_CPU_NKERNELS \
+    ((int) (sizeof (bigguy_cpu_kernels) / sizeof (bigguy_cpu_kernels[0])))
+
+/* Until a choice is made, the kernels are these, which make it and */
+/* then call the chosen kernel.                                      */
+
+static const bigguy_kernels *bigguy_cpu;
+
+static int first_addmult_chk (CCbigguy *x, CCbigguy y, long long m)
+{
+    cpu_start ();
+    return bigguy_cpu->addmult_chk (x, y, m);
+}
+
+static int first_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    cpu_start ();
+    return bigguy_cpu->dot_chk (acc, y, ind, m, n);
+}
+
+static int first_dtobigguy_array (const double *d, CCbigguy *x, int n)
+{
+    cpu_start ();
+    return bigguy_cpu->dtobigguy_array (d, x, n);
+}
+
+static void first_bigguytod_array (const CCbigguy *x, double *d, int n)
+{
+    cpu_start ();
+    bigguy_cpu->bigguytod_array (x, d, n);
+}
+
+static const bigguy_kernels bigguy_cpu_first = {
+    "auto", cpu_always, first_addmult_chk, first_dot_chk,
+    first_dtobigguy_array, first_bigguytod_array
+};
+
+static const bigguy_kernels *bigguy_cpu = &bigguy_cpu_first;
+
+#ifdef __GNUC__
+static void cpu_init (void) __attribute__ ((constructor));
+
+static void cpu_init (void)
+{
+    if (bigguy_cpu == &bigguy_cpu_first) cpu_start ();
+}
+#endif
+
+static void cpu_start (void)
+{
+    const char *s = getenv ("CC_BIGGUY_CPU");
+
+    if (s && *s && CCbigguy_cpu_select (s)) {
+        fprintf (stderr, "CC_BIGGUY_CPU=%s cannot be used here, ignored\n", s);
+        s = (const char *) NULL;
+    }
+    if (!s || !*s) CCbigguy_cpu_select ((const char *) NULL);
+}
+
+int CCbigguy_cpu_select (const char *name)
+{
+    int i;
+
+    if (!name || !strcmp (name, "auto")) {
+        for (i = BIGGUY_CPU_NKERNELS - 1; i > 0; i--) {
+            if (bigguy_cpu_kernels[i].usable ()) break;
+        }
+        bigguy_cpu = &bigguy_cpu_kernels[i];
+        return 0;
+    }
+    for (i = 0; i < BIGGUY_CPU_NKERNELS; i++) {
+        if (!strcmp (name, bigguy_cpu_kernels[i].name)) {
+            if (!bigguy_cpu_kernels[i].usable ()) return 1;
+            bigguy_cpu = &bigguy_cpu_kernels[i];
+            return 0;
+        }
+    }
+    return 1;
+}
+
+const char *CCbigguy_cpu_name (void)
+{
+    if (bigguy_cpu == &bigguy_cpu_first) cpu_start ();
+    return bigguy_cpu->name;
+}
+
+int CCbigguy_addmult_ll_chk (CCbigguy *x, CCbigguy y, long long m)
+{
+    CCbigguy_STATS_SAVE (x)
+    int r = bigguy_cpu->addmult_chk (x, y, m);
+
+    CCbigguy_STATS_ARITH (CCbigguy_STAT_ADDMULT, x, y, m, r);
+    return r;
+}
+
+void CCbigguy_addmult_ll (CCbigguy *x, CCbigguy y, long long m)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_addmult_ll_chk (x, y, m))) {
+        CCbigguy_overflow ("CCbigguy_addmult_ll");
+    }
+}
+
+int CCbigguy_addmult_chk (CCbigguy *x, CCbigguy y, int m)
+{
+    return CCbigguy_addmult_ll_chk (x, y, (long long) m);
+}
+
+void CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_addmult_ll_chk (x, y, (long long) m))) {
+        CCbigguy_overflow ("CCbigguy_addmult");
+    }
+}
+
+int CCbigguy_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *m, int n)
+{
+    int r = bigguy_cpu->dot_chk (acc, y, (const int *) NULL, m, n);
+
+    CCbigguy_STATS_RESULT (CCbigguy_STAT_DOT, r ? (CCbigguy *) NULL : acc, 1);
+    return r;
+}
+
+int CCbigguy_dot_sparse_chk (CCbigguy *acc, const CCbigguy *y,
+        const int *ind, const int *m, int n)
+{
+    int r = bigguy_cpu->dot_chk (acc, y, ind, m, n);
+
+    CCbigguy_STATS_RESULT (CCbigguy_STAT_DOT, r ? (CCbigguy *) NULL : acc, 1);
+    return r;
+}
+
+int CCbigguy_dtobigguy_array (const double *d, CCbigguy *x, int n)
+{
+    int r = bigguy_cpu->dtobigguy_array (d, x, n);
+
+    CCbigguy_STATS_RESULT (CCbigguy_STAT_DTOBIGGUY,
+                           r ? (CCbigguy *) NULL : x, n);
+    return r;
+}
+
+void CCbigguy_bigguytod_array (const CCbigguy *x, double *d, int n)
+{
+    CCbigguy_STATS_CALLS (CCbigguy_STAT_BIGGUYTOD, n);
+    bigguy_cpu->bigguytod_array (x, d, n);
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
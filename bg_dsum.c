@@ -0,0 +1,235 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  EXACT SUMS OF DOUBLES                                                   */
+/*                                                                          */
+/*  A CCbigguy_dsum holds the exact sum of any number of finite doubles     */
+/*  (and double*int products) in CCbigguy_DSUM_LANES signed 64-bit lanes,  */
+/*  lane k carrying weight 2^(32k-1088), so lane 32 is the 2^-64 digit of   */
+/*  a CCbigguy and the lanes span every double.  A double is added by       */
+/*  shifting its 53-bit mantissa by the low five bits of its exponent and   */
+/*  adding the pieces to the three lanes picked by the rest; no double is   */
+/*  converted to a CCbigguy.  As in a CCbigguy_wide, carries are only       */
+/*  propagated every BIGGUY_DSUM_MAXPENDING terms and at the end.           */
+/*                                                                          */
+/*  The sum is rounded once, when it is read: to the nearest multiple of    */
+/*  2^-64, ties to even, as in CCbigguy_dtobigguy.  So if every term is a   */
+/*  multiple of 2^-64, the result is the CCbigguy_add sum of the            */
+/*  CCbigguy_dtobigguy values, but intermediate sums may go out of range.   */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  void CCbigguy_dsum_init (CCbigguy_dsum *s)                              */
+/*    Sets s to 0.                                                          */
+/*                                                                          */
+/*  void CCbigguy_dsum_add (CCbigguy_dsum *s, double d)                     */
+/*  void CCbigguy_dsum_addmult (CCbigguy_dsum *s, double d, int m)          */
+/*    s += d and s += d*m.  Cannot overflow; an infinity or a NaN is        */
+/*    remembered and reported by CCbigguy_dsum_get.                         */
+/*                                                                          */
+/*  void CCbigguy_dsum_add_array (CCbigguy_dsum *s, const double *d,        */
+/*      int n)                                                              */
+/*  void CCbigguy_dsum_dot (CCbigguy_dsum *s, const double *d,              */
+/*      const int *m, int n)                                                */
+/*    s += d[0] + ... + d[n-1] and s += d[0]*m[0] + ... + d[n-1]*m[n-1].    */
+/*                                                                          */
+/*  int CCbigguy_dsum_get (CCbigguy_dsum *s, CCbigguy *x)                   */
+/*    Sets x to the rounded sum and returns 0, or returns 1 (leaving x      */
+/*    unchanged) if the sum does not fit in a CCbigguy or an infinity or    */
+/*    NaN was added.  The value of s is not changed, so more terms may      */
+/*    be added afterwards.                                                  */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define BIGGUY_DSUM_MAXPENDING (1 << 28)
+#define BIGGUY_DSUM_UNIT 32             /* the lane of 2^-64 */
+
+/* l[k..k+2] += v * 2^(32k+o-1088), for |v| < 2^63 and 0 <= o < 32; each  */
+/* lane changes by less than 2^33                                          */
+
+#define BIGGUY_DSUM_ADD64(l,k,o,v) {                                    \
+    unsigned long long u_ = (unsigned long long) (v);                   \
+    long long lo_ = (long long) ((u_ & 0xffffffff) << (o));             \
+    long long hi_ = (long long) ((unsigned long long)                   \
+                                 ((long long) u_ >> 32) << (o));        \
+    (l)[k] += lo_ & 0xffffffff;                                         \
+    (l)[(k)+1] += (lo_ >> 32) + (hi_ & 0xffffffff);                     \
+    (l)[(k)+2] += hi_ >> 32;                                            \
+}
+
+/* splits d into its signed mantissa v, lane k and shift o; a subnormal  */
+/* has the exponent of the smallest normal and no hidden bit             */
+
+#define BIGGUY_DSUM_SPLIT(d,v,k,o,bad) {                                \
+    unsigned long long b_;                                              \
+    long long s_;                                                       \
+    int e_;                                                             \
+    memcpy (&b_, &(d), sizeof (b_));                                    \
+    e_ = (int) ((b_ >> 52) & 0x7ff);                                    \
+    s_ = -(long long) (b_ >> 63);                                       \
+    (bad) |= (e_ == 0x7ff);                                             \
+    (v) = (long long) ((b_ & ((1ULL << 52) - 1)) |                      \
+                       ((unsigned long long) (e_ != 0) << 52));         \
+    (v) = ((v) ^ s_) - s_;                                              \
+    e_ += (e_ == 0) + 13;                                               \
+    (k) = e_ >> 5;                                                      \
+    (o) = e_ & 31;                                                      \
+}
+
+static void
+    dsum_normalize (long long *l);
+
+
+static void dsum_normalize (long long *l)
+{
+    int k;
+
+    for (k = 0; k < CCbigguy_DSUM_LANES - 1; k++) {
+        l[k+1] += l[k] >> 32;
+        l[k] &= 0xffffffff;
+    }
+}
+
+void CCbigguy_dsum_init (CCbigguy_dsum *s)
+{
+    memset (s->lane, 0, sizeof (s->lane));
+    s->pending = 0;
+    s->bad = 0;
+}
+
+void CCbigguy_dsum_add (CCbigguy_dsum *s, double d)
+{
+    long long v;
+    int k, o;
+
+    if (s->pending >= BIGGUY_DSUM_MAXPENDING) {
+        dsum_normalize (s->lane);
+        s->pending = 0;
+    }
+    BIGGUY_DSUM_SPLIT (d, v, k, o, s->bad);
+    BIGGUY_DSUM_ADD64 (s->lane, k, o, v);
+    s->pending++;
+}
+
+/* d*m is (v & 0xffffffff)*m plus (v >> 32)*m one lane up */
+
+void CCbigguy_dsum_addmult (CCbigguy_dsum *s, double d, int m)
+{
+    long long v;
+    int k, o;
+
+    if (s->pending >= BIGGUY_DSUM_MAXPENDING - 1) {
+        dsum_normalize (s->lane);
+        s->pending = 0;
+    }
+    BIGGUY_DSUM_SPLIT (d, v, k, o, s->bad);
+    BIGGUY_DSUM_ADD64 (s->lane, k, o, (v & 0xffffffff) * m);
+    BIGGUY_DSUM_ADD64 (s->lane, k + 1, o, (v >> 32) * m);
+    s->pending += 2;
+}
+
+void CCbigguy_dsum_add_array (CCbigguy_dsum *s, const double *d, int n)
+{
+    long long *l = s->lane;
+    long long v;
+    int i, j, k, o, stop, chunk, bad = 0;
+
+    for (i = 0; i < n; i = stop) {
+        if (s->pending >= BIGGUY_DSUM_MAXPENDING) {
+            dsum_normalize (l);
+            s->pending = 0;
+        }
+        chunk = BIGGUY_DSUM_MAXPENDING - s->pending;
+        stop = (n - i > chunk) ? i + chunk : n;
+        s->pending += stop - i;
+        for (j = i; j < stop; j++) {
+            BIGGUY_DSUM_SPLIT (d[j], v, k, o, bad);
+            BIGGUY_DSUM_ADD64 (l, k, o, v);
+        }
+    }
+    s->bad |= bad;
+}
+
+void CCbigguy_dsum_dot (CCbigguy_dsum *s, const double *d, const int *m,
+        int n)
+{
+    long long *l = s->lane;
+    long long v;
+    int i, j, k, o, stop, chunk, bad = 0;
+
+    for (i = 0; i < n; i = stop) {
+        if (s->pending >= BIGGUY_DSUM_MAXPENDING - 1) {
+            dsum_normalize (l);
+            s->pending = 0;
+        }
+        chunk = (BIGGUY_DSUM_MAXPENDING - s->pending) / 2;
+        stop = (n - i > chunk) ? i + chunk : n;
+        s->pending += 2 * (stop - i);
+        for (j = i; j < stop; j++) {
+            BIGGUY_DSUM_SPLIT (d[j], v, k, o, bad);
+            BIGGUY_DSUM_ADD64 (l, k, o, (v & 0xffffffff) * m[j]);
+            BIGGUY_DSUM_ADD64 (l, k + 1, o, (v >> 32) * m[j]);
+        }
+    }
+    s->bad |= bad;
+}
+
+int CCbigguy_dsum_get (CCbigguy_dsum *s, CCbigguy *x)
+{
+    long long *l = s->lane;
+    long long u[CCbigguy_DSUM_LANES - BIGGUY_DSUM_UNIT];
+    long long ext;
+    unsigned long long sticky = 0;
+    int k, n = CCbigguy_DSUM_LANES - BIGGUY_DSUM_UNIT;
+
+    if (s->bad) return 1;
+    dsum_normalize (l);
+    s->pending = 0;
+
+    /* the lanes below BIGGUY_DSUM_UNIT are the part under 2^-64; round  */
+    /* the rest (in u, so that s keeps the exact sum) up if that part is  */
+    /* over half, or exactly half and the rest is odd                     */
+    for (k = 0; k < BIGGUY_DSUM_UNIT - 1; k++) sticky |= l[k];
+    sticky |= l[BIGGUY_DSUM_UNIT-1] & 0x7fffffff;
+    for (k = 0; k < n; k++) u[k] = l[BIGGUY_DSUM_UNIT + k];
+    u[0] += (l[BIGGUY_DSUM_UNIT-1] >> 31) && (sticky || (u[0] & 1));
+    for (k = 0; k < n - 1; k++) {
+        u[k+1] += u[k] >> 32;
+        u[k] &= 0xffffffff;
+    }
+
+    /* u[0..3] are flo, fhi, ilo and ihi, and the rest must extend ihi */
+    ext = (u[3] >> 31) ? 0xffffffffLL : 0;
+    for (k = 4; k < n - 1; k++) {
+        if (u[k] != ext) return 1;
+    }
+    if (u[n-1] != (ext ? -1 : 0)) return 1;
+
+    x->ihi = (unsigned int) u[3];
+    x->ilo = (unsigned int) u[2];
+    x->fhi = (unsigned int) u[1];
+    x->flo = (unsigned int) u[0];
+    return 0;
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,161 @@
+// checks bigguy.hpp: constexpr arithmetic at compile time, overflow at run
+// time, and conversion to and from the C CCbigguy
+
+extern "C" {
+#include "machdefs.h"
+#include "util.h"
+}
+#include "bigguy.hpp"
+
+#include <cstddef>
+#include <cstdio>
+
+using concorde::bigguy;
+
+typedef bigguy<64, 64> bg128;
+typedef bigguy<32, 32> bg64;
+typedef bigguy<48, 16> bg48;
+
+// x + 1/2, built from limbs since only ints convert at compile time
+template <int I, int F>
+constexpr bigguy<I, F> plus_half(bigguy<I, F> x) {
+	bigguy<I, F> h;
+	h.limb[bigguy<I, F>::nlimbs - 1 - (F - 1) / 32] = 1u << ((F - 1) % 32);
+	return x + h;
+}
+
+template <int I, int F>
+constexpr bigguy<I, F> addmult(bigguy<I, F> x, const bigguy<I, F> &y, int m) {
+	x.addmult(y, m);
+	return x;
+}
+
+// true if every overflowing update reports it and leaves x unchanged
+template <int I, int F>
+constexpr bool overflows_keep() {
+	typedef bigguy<I, F> B;
+	B x = B::max();
+	B y = B::min();
+	bool ok = x.add_chk(B(1)) && x == B::max();
+	ok = ok && y.sub_chk(B(1)) && y == B::min();
+	ok = ok && x.addmult_chk(B(-1), -1) && x == B::max();
+	ok = ok && x.addmult_chk(B::max(), 2) && x == B::max();
+	ok = ok && !y.add_chk(B::max()) && y == B(0);
+	return ok;
+}
+
+template <int I, int F, int I2, int F2>
+constexpr bool convert_ovf(const bigguy<I2, F2> &y) {
+	bool ovf = false;
+	bigguy<I, F>::convert(y, &ovf);
+	return ovf;
+}
+
+// arithmetic and comparison
+static_assert(bg128(3) + bg128(-5) == bg128(-2), "bigguy +");
+static_assert(bg64(3) - bg64(-5) == bg64(8), "bigguy -");
+static_assert(-bg48(7) == bg48(-7), "bigguy unary -");
+static_assert(bg128(-1) < bg128(0) && bg128(0) < bg128(1), "bigguy <");
+static_assert(bg64::min() < bg64(-1) && bg64(1) < bg64::max(), "bigguy range");
+static_assert(bg48(2) >= bg48(2) && bg48(2) <= bg48(2) && bg48(2) != bg48(3),
+              "bigguy compare");
+static_assert(bg128(-4).cmp(bg128(4)) == -1 && bg128(4).cmp(bg128(4)) == 0,
+              "bigguy cmp");
+static_assert(addmult(bg128(1), bg128(-3), 0x7fffffff) ==
+              bg128(1) - bg128(0x7fffffff) - bg128(0x7fffffff) -
+              bg128(0x7fffffff), "bigguy addmult");
+static_assert(addmult(plus_half(bg64(0)), plus_half(bg64(1)), -2) ==
+              plus_half(bg64(-3)), "bigguy addmult with fractions");
+
+// ceil
+static_assert(plus_half(bg128(2)).ceil() == bg128(3), "bigguy ceil up");
+static_assert(plus_half(bg48(-3)).ceil() == bg48(-2), "bigguy ceil negative");
+static_assert(bg64(5).ceil() == bg64(5), "bigguy ceil integer");
+
+// overflow leaves the value alone
+static_assert(overflows_keep<64, 64>(), "bigguy<64,64> overflow");
+static_assert(overflows_keep<32, 32>(), "bigguy<32,32> overflow");
+static_assert(overflows_keep<48, 16>(), "bigguy<48,16> overflow");
+static_assert(overflows_keep<96, 32>(), "bigguy<96,32> overflow");
+
+// convert truncates toward -infinity and flags integer overflow
+static_assert(bg64::convert(bg128(-123456), nullptr) == bg64(-123456),
+              "bigguy convert narrows");
+static_assert(bigguy<64, 0>::convert(plus_half(bg128(-2)), nullptr) ==
+              bigguy<64, 0>(-2), "bigguy convert truncates");
+static_assert(!convert_ovf<32, 32>(bg128(0x7fffffff)) &&
+              convert_ovf<32, 32>(bg128(0x7fffffff) + bg128(1)) &&
+              !convert_ovf<32, 32>(bg128(-0x7fffffff - 1)) &&
+              convert_ovf<32, 32>(bg128(-0x7fffffff - 1) - bg128(1)),
+              "bigguy convert range");
+static_assert(convert_ovf<48, 16>(bg128::max()) &&
+              !convert_ovf<128, 64>(bg128::min()), "bigguy convert widths");
+
+#ifndef CC_BIGGUY_BUILTIN
+static_assert(offsetof(CCbigguy, ihi) == 0 &&
+              offsetof(CCbigguy, ilo) == sizeof(unsigned int) &&
+              offsetof(CCbigguy, fhi) == 2 * sizeof(unsigned int) &&
+              offsetof(CCbigguy, flo) == 3 * sizeof(unsigned int),
+              "CCbigguy limbs are most significant first");
+#endif
+
+int main(void) {
+	int bad = 0;
+
+	// run time overflow, as at compile time
+	if (!overflows_keep<64, 64>() || !overflows_keep<48, 16>()) bad = 1;
+	{
+		bg64 x = bg64::max();
+		bool ovf = false;
+		if (!x.add_chk(plus_half(bg64(0))) || x != bg64::max()) bad = 1;
+		if (x.sub_chk(bg64::max()) || x != bg64(0)) bad = 1;
+		bg64::convert(bg48::max(), &ovf);
+		if (!ovf) bad = 1;
+		if (bg128::convert(bg64::min(), &ovf) != bg128::convert(bg64::min(), nullptr) || ovf) bad = 1;
+	}
+
+#ifndef CC_BIGGUY_BUILTIN
+	// to_c and from_c round trip and agree with the C routines
+	{
+		enum { nval = 9 };
+		const double d[nval] = {0.0, 0.5, -0.5, 1.0 / 3, -1e9 / 7,
+		                        32767.9999847412109375, -2147483647.5,
+		                        1e18 / 3, -1.6180339887e12};
+		CCbigguy c[nval];
+		for (int i = 0; i < nval; i++) c[i] = CCbigguy_dtobigguy(d[i]);
+		c[nval - 2] = CCbigguy_MAXBIGGUY;
+		c[nval - 1] = CCbigguy_MINBIGGUY;
+		for (int i = 0; i < nval; i++) {
+			bg128 x = bg128::from_c(c[i]);
+			bigguy<96, 64> w = bigguy<96, 64>::from_c(c[i]);
+			CCbigguy t;
+			if (CCbigguy_cmp(x.to_c(), c[i])) bad = 1;
+			if (CCbigguy_cmp(w.to_c(), c[i])) bad = 1;
+			if (x.to_double() != CCbigguy_bigguytod(c[i])) bad = 1;
+			if (i < nval - 2) {
+				t = CCbigguy_ceil(c[i]);
+				if (CCbigguy_cmp(x.ceil().to_c(), t)) bad = 1;
+			}
+			for (int j = 0; j < nval; j++) {
+				bg128 y = bg128::from_c(c[j]);
+				bool ovf;
+				if ((x < y) != (CCbigguy_cmp(c[i], c[j]) < 0)) bad = 1;
+				t = c[j];
+				ovf = CCbigguy_add_chk(&t, c[i]) != 0;
+				if (ovf != y.add_chk(x) || CCbigguy_cmp(y.to_c(), t)) bad = 1;
+				y = bg128::from_c(c[j]);
+				t = c[j];
+				ovf = CCbigguy_addmult_chk(&t, c[i], -3) != 0;
+				if (ovf != y.addmult_chk(x, -3) || CCbigguy_cmp(y.to_c(), t)) bad = 1;
+			}
+		}
+	}
+#endif
+
+	if (bad) {
+		printf("bigguy.hpp failed\n");
+	}
+	else
+		printf("PASS bigguy.hpp\n");
+	return 0;
+}
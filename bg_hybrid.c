@@ -0,0 +1,157 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  ADAPTIVE PRECISION BIGGUYS                                              */
+/*                                                                          */
+/*  A CCbigguy_hybrid holds its value as a 32.32 fixed point long long      */
+/*  (the CC_BIGGUY_BUILTIN layout) while the value fits, and as a           */
+/*  CCbigguy otherwise.  An operation is first tried in 64 bits with        */
+/*  overflow checking; if the operand has bits outside 32.32 or the 64-bit  */
+/*  result overflows, it is redone with the checked 128-bit routines.       */
+/*  Results that fit in 32.32 again are moved back to the 64-bit form.      */
+/*  Since both forms are exact, the results (and the overflow behaviour)    */
+/*  are those of the plain CCbigguy routines.                               */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  void CCbigguy_hybrid_init (CCbigguy_hybrid *h, CCbigguy x)              */
+/*    Sets h to x.                                                          */
+/*                                                                          */
+/*  CCbigguy CCbigguy_hybrid_get (const CCbigguy_hybrid *h)                 */
+/*    Returns the value of h.                                               */
+/*                                                                          */
+/*  void CCbigguy_hybrid_add (CCbigguy_hybrid *h, CCbigguy y)               */
+/*  void CCbigguy_hybrid_sub (CCbigguy_hybrid *h, CCbigguy y)               */
+/*  void CCbigguy_hybrid_addmult (CCbigguy_hybrid *h, CCbigguy y, int m)    */
+/*    h += y, h -= y and h += y*m.  If an overflow occurs, an error         */
+/*    message is output and the routine aborts.                             */
+/*                                                                          */
+/*  int CCbigguy_hybrid_addmult_chk (CCbigguy_hybrid *h, CCbigguy y,        */
+/*      int m)                                                              */
+/*    h += y*m, returning 1 (with h unchanged) on overflow, 0 otherwise.    */
+/*                                                                          */
+/*  int CCbigguy_hybrid_cmp (const CCbigguy_hybrid *h, CCbigguy y)          */
+/*    As CCbigguy_cmp.                                                      */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+/* x fits in 32.32 iff flo is 0 and ihi is the sign extension of ilo */
+
+#define HYBRID_FITS(x) ((x).flo == 0 &&                                     \
+                        (x).ihi == (((x).ilo >> 31) ? BIT_32_UMAX : 0))
+#define HYBRID_SMALL(x) ((long long) (((unsigned long long) (x).ilo << 32)   \
+                                      | (x).fhi))
+
+static void
+    hybrid_set (CCbigguy_hybrid *h, CCbigguy x);
+
+static int
+    hybrid_addmult_big (CCbigguy_hybrid *h, CCbigguy y, int m);
+
+
+static void hybrid_set (CCbigguy_hybrid *h, CCbigguy x)
+{
+    if (HYBRID_FITS (x)) {
+        h->val = HYBRID_SMALL (x);
+        h->isbig = 0;
+    } else {
+        h->big = x;
+        h->isbig = 1;
+    }
+}
+
+void CCbigguy_hybrid_init (CCbigguy_hybrid *h, CCbigguy x)
+{
+    hybrid_set (h, x);
+}
+
+CCbigguy CCbigguy_hybrid_get (const CCbigguy_hybrid *h)
+{
+    CCbigguy x;
+
+    if (h->isbig) return h->big;
+
+    x.ihi = (h->val < 0) ? BIT_32_UMAX : 0;
+    x.ilo = (unsigned int) ((unsigned long long) h->val >> 32);
+    x.fhi = (unsigned int) h->val;
+    x.flo = 0;
+    return x;
+}
+
+static int hybrid_addmult_big (CCbigguy_hybrid *h, CCbigguy y, int m)
+{
+    CCbigguy x = CCbigguy_hybrid_get (h);
+
+    if (CCbigguy_addmult_chk (&x, y, m)) return 1;
+    hybrid_set (h, x);
+    return 0;
+}
+
+int CCbigguy_hybrid_addmult_chk (CCbigguy_hybrid *h, CCbigguy y, int m)
+{
+#ifdef __GNUC__
+    long long p, s;
+
+    if (!h->isbig && HYBRID_FITS (y) &&
+        !__builtin_mul_overflow (HYBRID_SMALL (y), (long long) m, &p) &&
+        !__builtin_add_overflow (h->val, p, &s)) {
+        h->val = s;
+        return 0;
+    }
+#endif
+    return hybrid_addmult_big (h, y, m);
+}
+
+void CCbigguy_hybrid_addmult (CCbigguy_hybrid *h, CCbigguy y, int m)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_hybrid_addmult_chk (h, y, m))) {
+        CCbigguy_overflow ("CCbigguy_hybrid_addmult");
+    }
+}
+
+void CCbigguy_hybrid_add (CCbigguy_hybrid *h, CCbigguy y)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_hybrid_addmult_chk (h, y, 1))) {
+        CCbigguy_overflow ("CCbigguy_hybrid_add");
+    }
+}
+
+void CCbigguy_hybrid_sub (CCbigguy_hybrid *h, CCbigguy y)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_hybrid_addmult_chk (h, y, -1))) {
+        CCbigguy_overflow ("CCbigguy_hybrid_sub");
+    }
+}
+
+int CCbigguy_hybrid_cmp (const CCbigguy_hybrid *h, CCbigguy y)
+{
+    long long ys;
+
+    if (!h->isbig && HYBRID_FITS (y)) {
+        ys = HYBRID_SMALL (y);
+        return (h->val > ys) - (h->val < ys);
+    }
+    return CCbigguy_cmp (CCbigguy_hybrid_get (h), y);
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,487 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  The bigguy add, sub, addmult, cmp and ceil routines and the exact       */
+/*  double conversions, as static inline functions.  bigguy.c builds the    */
+/*  exported symbols from these (and bg_cpu.c its per-CPU kernels); if      */
+/*  CC_BIGGUY_INLINE is defined, bigguy.h also includes this file and maps  */
+/*  the public names onto CCbigguy_inline_*, so the arithmetic is inlined   */
+/*  into the caller.  Overflows are still reported by the out-of-line       */
+/*  CCbigguy_overflow.  Include bigguy.h, not this file.                    */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef  __BG_INLINE_H
+#define  __BG_INLINE_H
+
+#ifndef CC_BIGGUY_BUILTIN
+
+/* CCbigguy_KEYHI(x):CCbigguy_KEYLO(x) is an unsigned 128-bit key that */
+/* orders like x: flip the sign bit and read the limbs as one           */
+/* big-endian number.                                                   */
+
+#define CCbigguy_KEYHI(x) (((unsigned long long) ((x).ihi ^ 0x80000000u) \
+                            << 32) | (unsigned long long) (x).ilo)
+#define CCbigguy_KEYLO(x) (((unsigned long long) (x).fhi << 32) |         \
+                           (unsigned long long) (x).flo)
+
+#if defined(CC_BIGGUY_INT128) && defined(__SIZEOF_INT128__)
+#define CCbigguy_USE_INT128
+
+typedef __int128 CCbigguy_i128;
+
+/* The 128-bit backend views a CCbigguy as a signed high limb (ihi:ilo)    */
+/* and an unsigned low limb (fhi:flo).                                     */
+
+#define CCbigguy_HI(x) ((long long) (((unsigned long long) (x).ihi << 32) | \
+                                     (unsigned long long) (x).ilo))
+#define CCbigguy_LO(x) (((unsigned long long) (x).fhi << 32) |               \
+                        (unsigned long long) (x).flo)
+#define CCbigguy_SETHI(x,v) {                                          \
+    (x).ihi = (unsigned int) ((unsigned long long) (v) >> 32);         \
+    (x).ilo = (unsigned int) (v);                                      \
+}
+#define CCbigguy_SETLO(x,v) {                                          \
+    (x).fhi = (unsigned int) ((v) >> 32);                              \
+    (x).flo = (unsigned int) (v);                                      \
+}
+#define CCbigguy_LOAD(x) ((CCbigguy_i128)                              \
+        (((unsigned __int128) CCbigguy_HI(x) << 64) | CCbigguy_LO(x)))
+#define CCbigguy_STORE(x,v) {                                          \
+    CCbigguy_SETHI (x, (long long) ((v) >> 64));                       \
+    CCbigguy_SETLO (x, (unsigned long long) (v));                      \
+}
+#endif
+
+/* a*b = (*hi:low 64 bits) */
+
+static inline unsigned long long CCbigguy_inline_umul64 (unsigned long long a,
+        unsigned long long b, unsigned long long *hi)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 p = (unsigned __int128) a * b;
+
+    *hi = (unsigned long long) (p >> 64);
+    return (unsigned long long) p;
+#else
+    unsigned long long a0 = a & 0xffffffffULL, a1 = a >> 32;
+    unsigned long long b0 = b & 0xffffffffULL, b1 = b >> 32;
+    unsigned long long p00 = a0 * b0, p01 = a0 * b1;
+    unsigned long long p10 = a1 * b0, p11 = a1 * b1;
+    unsigned long long mid = (p00 >> 32) + (p01 & 0xffffffffULL) +
+                             (p10 & 0xffffffffULL);
+
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xffffffffULL);
+#endif
+}
+
+#ifdef CCbigguy_USE_INT128
+
+static inline int CCbigguy_inline_ceil_chk (CCbigguy *x)
+{
+    long long hi;
+
+    if (CCbigguy_LO(*x)) {
+        if (CCbigguy_UNLIKELY (__builtin_add_overflow (CCbigguy_HI(*x), 1LL, &hi))) {
+            return 1;
+        }
+        CCbigguy_SETHI (*x, hi);
+        x->fhi = 0;
+        x->flo = 0;
+    }
+
+    return 0;
+}
+
+static inline int CCbigguy_inline_cmp (CCbigguy x, CCbigguy y)
+{
+    CCbigguy_i128 a = CCbigguy_LOAD(x);
+    CCbigguy_i128 b = CCbigguy_LOAD(y);
+
+    return (a > b) - (a < b);
+}
+
+static inline int CCbigguy_inline_add_chk (CCbigguy *x, CCbigguy y)
+{
+    CCbigguy_i128 s;
+
+    if (CCbigguy_UNLIKELY (__builtin_add_overflow (CCbigguy_LOAD(*x),
+                                                   CCbigguy_LOAD(y), &s))) {
+        return 1;
+    }
+    CCbigguy_STORE (*x, s);
+    return 0;
+}
+
+static inline int CCbigguy_inline_sub_chk (CCbigguy *x, CCbigguy y)
+{
+    CCbigguy_i128 s;
+
+    if (CCbigguy_UNLIKELY (__builtin_sub_overflow (CCbigguy_LOAD(*x),
+                                                   CCbigguy_LOAD(y), &s))) {
+        return 1;
+    }
+    CCbigguy_STORE (*x, s);
+    return 0;
+}
+
+static inline int CCbigguy_inline_addmult_ll_chk (CCbigguy *x, CCbigguy y,
+        long long m)
+{
+    CCbigguy_i128 plo, phi;
+    unsigned long long lo;
+    long long hi;
+    int c;
+
+    if (m == 1) {
+        return CCbigguy_inline_add_chk (x, y);
+    } else if (m == -1) {
+        return CCbigguy_inline_sub_chk (x, y);
+    } else if (m == 0) {
+        return 0;
+    }
+
+    /* y*m = phi * 2^64 + (low 64 bits of plo), with |phi| < 2^127 */
+    plo = (CCbigguy_i128) CCbigguy_LO(y) * m;
+    phi = (CCbigguy_i128) CCbigguy_HI(y) * m + (plo >> 64);
+
+    c = __builtin_add_overflow (CCbigguy_LO(*x), (unsigned long long) plo, &lo);
+    phi += (CCbigguy_i128) CCbigguy_HI(*x) + c;
+    hi = (long long) phi;
+    if (CCbigguy_UNLIKELY ((CCbigguy_i128) hi != phi)) {
+        return 1;
+    }
+
+    CCbigguy_SETHI (*x, hi);
+    CCbigguy_SETLO (*x, lo);
+    return 0;
+}
+
+#else  /* CCbigguy_USE_INT128 */
+
+static inline int CCbigguy_inline_ceil_chk (CCbigguy *x)
+{
+    if ((unsigned int) x->fhi || (unsigned int) x->flo) {
+        if ((unsigned int) x->ilo == BIT_32_UMAX) {
+            if (CCbigguy_UNLIKELY ((unsigned int) x->ihi == BIT_32_SMAX)) {
+                return 1;
+            }
+            x->ihi = (unsigned int) x->ihi + 1;
+        }
+        x->ilo = (unsigned int) x->ilo + 1;
+        x->fhi = 0;
+        x->flo = 0;
+    }
+
+    return 0;
+}
+
+/* no branches: the compares become flag sets */
+
+static inline int CCbigguy_inline_cmp (CCbigguy x, CCbigguy y)
+{
+    unsigned long long xh = CCbigguy_KEYHI(x), yh = CCbigguy_KEYHI(y);
+    unsigned long long xl = CCbigguy_KEYLO(x), yl = CCbigguy_KEYLO(y);
+    int gt = (xh > yh) | ((xh == yh) & (xl > yl));
+    int lt = (xh < yh) | ((xh == yh) & (xl < yl));
+
+    return gt - lt;
+}
+
+static inline int CCbigguy_inline_add_chk (CCbigguy *x, CCbigguy y)
+{
+    unsigned long int carry;
+    CCbigguy z;
+
+    carry = (unsigned long int) x->flo + y.flo;
+    z.flo = (unsigned int) carry;
+    carry = (carry >> 32) + x->fhi + y.fhi;
+    z.fhi = (unsigned int) carry;
+    carry = (carry >> 32) + x->ilo + y.ilo;
+    z.ilo = (unsigned int) carry;
+    carry = (carry >> 32) + x->ihi + y.ihi;
+    z.ihi = (unsigned int) carry;
+
+    /* overflow iff x and y have the same sign and the sum does not */
+    if (CCbigguy_UNLIKELY (((x->ihi ^ z.ihi) & (y.ihi ^ z.ihi)) >= 2147483648)) {
+        return 1;
+    }
+    *x = z;
+    return 0;
+}
+
+static inline int CCbigguy_inline_sub_chk (CCbigguy *x, CCbigguy y)
+{
+    unsigned long int carry;
+    CCbigguy z;
+
+    /* x - y = x + ~y + 1 */
+    carry = (unsigned long int) x->flo + (unsigned int) ~y.flo + 1;
+    z.flo = (unsigned int) carry;
+    carry = (carry >> 32) + x->fhi + (unsigned int) ~y.fhi;
+    z.fhi = (unsigned int) carry;
+    carry = (carry >> 32) + x->ilo + (unsigned int) ~y.ilo;
+    z.ilo = (unsigned int) carry;
+    carry = (carry >> 32) + x->ihi + (unsigned int) ~y.ihi;
+    z.ihi = (unsigned int) carry;
+
+    /* overflow iff x and y have different signs and x - y has y's sign */
+    if (CCbigguy_UNLIKELY (((x->ihi ^ y.ihi) & (x->ihi ^ z.ihi)) >= 2147483648)) {
+        return 1;
+    }
+    *x = z;
+    return 0;
+}
+
+/* |y| * |m| in one pass of 64x64 multiplies, negated if the signs */
+/* differ and added to x as 192-bit numbers; it fits iff the top    */
+/* limb of the sum is the sign of the middle one                    */
+
+static inline int CCbigguy_inline_addmult_ll_chk (CCbigguy *x, CCbigguy y,
+        long long m)
+{
+    unsigned long long y0, y1, mu, p0, p1, p2, t, neg, mask, c;
+    unsigned long long x0, x1, x2;
+
+    if (m == 1) {
+        return CCbigguy_inline_add_chk (x, y);
+    } else if (m == -1) {
+        return CCbigguy_inline_sub_chk (x, y);
+    } else if (m == 0) {
+        return 0;
+    }
+
+    y0 = ((unsigned long long) y.fhi << 32) | y.flo;
+    y1 = ((unsigned long long) y.ihi << 32) | y.ilo;
+    neg = y1 >> 63;
+    mask = 0 - neg;
+    y0 = (y0 ^ mask) + neg;
+    y1 = (y1 ^ mask) + (neg & (y0 == 0));
+    mu = (m < 0) ? 0 - (unsigned long long) m : (unsigned long long) m;
+    neg ^= (unsigned long long) (m < 0);
+
+    p0 = CCbigguy_inline_umul64 (y0, mu, &t);
+    p1 = CCbigguy_inline_umul64 (y1, mu, &p2);
+    p1 += t;
+    p2 += (p1 < t);
+
+    mask = 0 - neg;
+    p0 = (p0 ^ mask) + neg;
+    c = neg & (p0 == 0);
+    p1 = (p1 ^ mask) + c;
+    c &= (p1 == 0);
+    p2 = (p2 ^ mask) + c;
+
+    x0 = ((unsigned long long) x->fhi << 32) | x->flo;
+    x1 = ((unsigned long long) x->ihi << 32) | x->ilo;
+    x2 = 0 - (x1 >> 63);
+    x0 += p0;
+    c = (x0 < p0);
+    t = x1 + c;
+    c = (t < c);
+    x1 = t + p1;
+    c += (x1 < p1);
+    x2 += p2 + c;
+    if (CCbigguy_UNLIKELY (x2 != 0 - (x1 >> 63))) return 1;
+
+    x->ihi = (unsigned int) (x1 >> 32);
+    x->ilo = (unsigned int) x1;
+    x->fhi = (unsigned int) (x0 >> 32);
+    x->flo = (unsigned int) x0;
+    return 0;
+}
+
+#endif /* CCbigguy_USE_INT128 */
+
+static inline void CCbigguy_inline_add (CCbigguy *x, CCbigguy y)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_inline_add_chk (x, y))) {
+        CCbigguy_overflow ("CCbigguy_add");
+    }
+}
+
+static inline void CCbigguy_inline_sub (CCbigguy *x, CCbigguy y)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_inline_sub_chk (x, y))) {
+        CCbigguy_overflow ("CCbigguy_sub");
+    }
+}
+
+static inline int CCbigguy_inline_addmult_chk (CCbigguy *x, CCbigguy y, int m)
+{
+    return CCbigguy_inline_addmult_ll_chk (x, y, (long long) m);
+}
+
+static inline void CCbigguy_inline_addmult (CCbigguy *x, CCbigguy y, int m)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_inline_addmult_ll_chk (x, y,
+                                                          (long long) m))) {
+        CCbigguy_overflow ("CCbigguy_addmult");
+    }
+}
+
+static inline void CCbigguy_inline_addmult_ll (CCbigguy *x, CCbigguy y,
+        long long m)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_inline_addmult_ll_chk (x, y, m))) {
+        CCbigguy_overflow ("CCbigguy_addmult_ll");
+    }
+}
+
+static inline CCbigguy CCbigguy_inline_ceil (CCbigguy x)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_inline_ceil_chk (&x))) {
+        CCbigguy_overflow ("CCbigguy_ceil");
+    }
+    return x;
+}
+
+/* 2^e, for -1022 <= e <= 1023 */
+
+static inline double CCbigguy_inline_pow2 (int e)
+{
+    unsigned long long b = (unsigned long long) (e + 1023) << 52;
+    double d;
+
+    memcpy (&d, &b, sizeof (d));
+    return d;
+}
+
+/* the number of leading zero bits of v, which is nonzero */
+
+static inline int CCbigguy_inline_clz64 (unsigned long long v)
+{
+#ifdef __GNUC__
+    return __builtin_clzll (v);
+#else
+    int k = 0;
+
+    while (!(v >> 63)) {
+        v <<= 1;
+        k++;
+    }
+    return k;
+#endif
+}
+
+static inline double CCbigguy_inline_bigguytod (CCbigguy x)
+{
+    unsigned long long hi = ((unsigned long long) x.ihi << 32) | x.ilo;
+    unsigned long long lo = ((unsigned long long) x.fhi << 32) | x.flo;
+    unsigned long long neg = 0 - (unsigned long long) (x.ihi >> 31);
+    unsigned long long q, rnd, sticky;
+    int lz;
+    double d;
+
+    /* |x| as an unsigned hi:lo, so |-2^127| is no special case */
+    lo = (lo ^ neg) - neg;
+    hi = (hi ^ neg) + (neg & (unsigned long long) (lo == 0));
+    if (!(hi | lo)) return 0.0;
+
+    /* shift the leading one to bit 127 of hi:lo */
+    if (hi) {
+        lz = CCbigguy_inline_clz64 (hi);
+        if (lz) {
+            hi = (hi << lz) | (lo >> (64 - lz));
+            lo <<= lz;
+        }
+    } else {
+        lz = CCbigguy_inline_clz64 (lo);
+        hi = lo << lz;
+        lo = 0;
+        lz += 64;
+    }
+
+    /* keep 53 bits, rounding to nearest with ties to even */
+    q = hi >> 11;
+    rnd = (hi >> 10) & 1;
+    sticky = (hi & 0x3ff) | lo;
+    q += rnd & ((sticky != 0) | q);
+
+    d = (double) (long long) q * CCbigguy_inline_pow2 (11 - lz);
+    return neg ? -d : d;
+}
+
+static inline int CCbigguy_inline_dtobigguy_chk (double d, CCbigguy *y)
+{
+    unsigned long long b, m, hi, lo, rest, half, neg;
+    int s;
+
+    memcpy (&b, &d, sizeof (b));
+    neg = 0 - (b >> 63);
+    s = (int) ((b >> 52) & 0x7ff);
+
+    /* |d| < 2^63 iff the biased exponent is below 1086; this also */
+    /* rejects infinities and NaNs                                  */
+    if (CCbigguy_UNLIKELY (s >= 1086)) return 1;
+
+    /* |d| * 2^64 = m * 2^s; subnormals (and zero) round to zero */
+    m = (b & ((1ULL << 52) - 1)) | (1ULL << 52);
+    s -= 1011;
+
+    if (s >= 64) {
+        hi = m << (s - 64);
+        lo = 0;
+    } else if (s > 0) {
+        hi = m >> (64 - s);
+        lo = m << s;
+    } else if (s > -54) {
+        hi = 0;
+        lo = m >> -s;
+        if (s < 0) {
+            rest = m & ((1ULL << -s) - 1);
+            half = 1ULL << (-s - 1);
+            lo += (rest > half) | ((rest == half) & lo);
+        }
+    } else {
+        hi = 0;
+        lo = 0;
+    }
+
+    lo = (lo ^ neg) - neg;
+    hi = (hi ^ neg) + (neg & (unsigned long long) (lo == 0));
+
+    y->ihi = (unsigned int) (hi >> 32);
+    y->ilo = (unsigned int) hi;
+    y->fhi = (unsigned int) (lo >> 32);
+    y->flo = (unsigned int) lo;
+    return 0;
+}
+
+/* The hooks of the CC_BIGGUY_STATS build (bg_stats.c).  A routine     */
+/* opens with CCbigguy_STATS_SAVE (x) among its declarations and reports */
+/* x + y*m, with ovf set if it overflowed, by CCbigguy_STATS_ARITH.      */
+/* Without CC_BIGGUY_STATS they are all empty.                           */
+
+#ifdef CC_BIGGUY_STATS
+#define CCbigguy_STATS_SAVE(x) CCbigguy stats_old = *(x);
+#define CCbigguy_STATS_ARITH(op,x,y,m,ovf)                              \
+    CCbigguy_stats_arith (op, &stats_old, y, m,                         \
+                          (ovf) ? (const CCbigguy *) NULL : (x))
+#define CCbigguy_STATS_CALLS(op,n) CCbigguy_stats_calls (op, n)
+#define CCbigguy_STATS_RESULT(op,r,n) CCbigguy_stats_result (op, r, n)
+#else
+#define CCbigguy_STATS_SAVE(x)
+#define CCbigguy_STATS_ARITH(op,x,y,m,ovf)
+#define CCbigguy_STATS_CALLS(op,n)
+#define CCbigguy_STATS_RESULT(op,r,n)
+#endif
+
+#endif /* CC_BIGGUY_BUILTIN */
+
+#endif /* __BG_INLINE_H */
@@ -0,0 +1,317 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  MAPPED BIGGUY ARRAYS                                                    */
+/*                                                                          */
+/*  A native bigguy file is a 64 byte header, the array in the in-memory    */
+/*  CCbigguy layout (starting at offset 64, so it is aligned in a mapped    */
+/*  file), and an 8 byte checksum of the payload.  The header holds         */
+/*                                                                          */
+/*      char magic[8]          "CCBIGGUY"                                   */
+/*      unsigned int version   CCbigguy_MAP_VERSION                         */
+/*      unsigned int endian    0x01020304, as written by the host           */
+/*      unsigned int valsize   sizeof (CCbigguy)                            */
+/*      unsigned int fracbits  32 or 64                                     */
+/*      unsigned long long n   the number of values                         */
+/*                                                                          */
+/*  followed by zeros.  The file can only be mapped on a host with the      */
+/*  same endianness and layout; use CCbigguy_swrite_array for portable      */
+/*  files.                                                                  */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_map_write (const char *fname, const CCbigguy *x, int n)    */
+/*    Writes x[0..n-1] to fname in the native format.  Fails, leaving       */
+/*    fname alone, if n < 0.                                                */
+/*                                                                          */
+/*  int CCbigguy_map_open (CCbigguy_map *m, const char *fname, int verify)  */
+/*    Maps fname read-only and sets m->x and m->n to the array it holds,    */
+/*    without copying.  The header is always checked; the checksum is only  */
+/*    checked if verify is nonzero, since that touches every page.  If      */
+/*    CC_BIGGUY_NOMMAP is defined, the file is read into memory instead.    */
+/*    Returns 0 on success, 1 on failure.                                   */
+/*                                                                          */
+/*  void CCbigguy_map_close (CCbigguy_map *m)                               */
+/*    Unmaps the file.                                                      */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_NOMMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define BIGGUY_MAP_HDRSIZE 64
+#define BIGGUY_MAP_ENDIAN 0x01020304
+
+typedef struct bigguy_map_hdr {
+    char magic[8];
+    unsigned int version;
+    unsigned int endian;
+    unsigned int valsize;
+    unsigned int fracbits;
+    unsigned long long n;
+    char pad[BIGGUY_MAP_HDRSIZE - 32];
+} bigguy_map_hdr;
+
+#ifdef CC_BIGGUY_BUILTIN
+#define BIGGUY_MAP_FRACBITS 32
+#else
+#define BIGGUY_MAP_FRACBITS 64
+#endif
+
+static void
+    map_header (bigguy_map_hdr *h, unsigned long long n);
+
+static int
+    map_header_ok (const bigguy_map_hdr *h, const char *fname, size_t len);
+
+static unsigned long long
+    map_checksum (const CCbigguy *x, unsigned long long n);
+
+
+static void map_header (bigguy_map_hdr *h, unsigned long long n)
+{
+    memset (h, 0, sizeof (bigguy_map_hdr));
+    memcpy (h->magic, "CCBIGGUY", 8);
+    h->version = CCbigguy_MAP_VERSION;
+    h->endian = BIGGUY_MAP_ENDIAN;
+    h->valsize = (unsigned int) sizeof (CCbigguy);
+    h->fracbits = BIGGUY_MAP_FRACBITS;
+    h->n = n;
+}
+
+static int map_header_ok (const bigguy_map_hdr *h, const char *fname,
+        size_t len)
+{
+    if (len < BIGGUY_MAP_HDRSIZE || memcmp (h->magic, "CCBIGGUY", 8)) {
+        fprintf (stderr, "%s is not a bigguy file\n", fname);
+        return 0;
+    }
+    if (h->version != CCbigguy_MAP_VERSION) {
+        fprintf (stderr, "%s has version %u, expected %u\n", fname,
+                 h->version, (unsigned int) CCbigguy_MAP_VERSION);
+        return 0;
+    }
+    if (h->endian != BIGGUY_MAP_ENDIAN || h->valsize != sizeof (CCbigguy) ||
+        h->fracbits != BIGGUY_MAP_FRACBITS) {
+        fprintf (stderr, "%s was written with a different bigguy layout\n",
+                 fname);
+        return 0;
+    }
+    if (h->n > (unsigned long long) BIT_32_SMAX ||
+        len != BIGGUY_MAP_HDRSIZE + h->n * sizeof (CCbigguy) + 8) {
+        fprintf (stderr, "%s has the wrong size for %llu bigguys\n", fname,
+                 h->n);
+        return 0;
+    }
+    return 1;
+}
+
+/* Fletcher-style sums of the 32-bit words, so that order matters */
+
+static unsigned long long map_checksum (const CCbigguy *x,
+        unsigned long long n)
+{
+    const unsigned int *w = (const unsigned int *) x;
+    unsigned long long a = 0, b = 0, i;
+
+    n *= sizeof (CCbigguy) / sizeof (unsigned int);
+    for (i = 0; i < n; i++) {
+        a += w[i];
+        b += a;
+    }
+    return (b << 32) ^ a;
+}
+
+int CCbigguy_map_write (const char *fname, const CCbigguy *x, int n)
+{
+    int rval = 0;
+    FILE *out = (FILE *) NULL;
+    bigguy_map_hdr h;
+    unsigned long long sum;
+
+    if (n < 0) {
+        fprintf (stderr, "Negative array size %d for %s\n", n, fname);
+        rval = 1; goto CLEANUP;
+    }
+
+    out = fopen (fname, "wb");
+    if (!out) {
+        perror (fname);
+        fprintf (stderr, "Unable to open %s for output\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+
+    map_header (&h, (unsigned long long) n);
+    sum = map_checksum (x, (unsigned long long) n);
+    if (fwrite (&h, sizeof (h), 1, out) != 1 ||
+        fwrite (x, sizeof (CCbigguy), (size_t) n, out) != (size_t) n ||
+        fwrite (&sum, sizeof (sum), 1, out) != 1) {
+        perror (fname);
+        fprintf (stderr, "Unable to write %s\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+
+CLEANUP:
+    if (out && fclose (out)) {
+        perror (fname);
+        rval = 1;
+    }
+    return rval;
+}
+
+#ifndef CC_BIGGUY_NOMMAP
+
+int CCbigguy_map_open (CCbigguy_map *m, const char *fname, int verify)
+{
+    int rval = 0;
+    int fd = -1;
+    struct stat st;
+    const char *p;
+    unsigned long long sum;
+
+    m->x = (const CCbigguy *) NULL;
+    m->n = 0;
+    m->base = (void *) NULL;
+    m->len = 0;
+
+    fd = open (fname, O_RDONLY);
+    if (fd == -1 || fstat (fd, &st)) {
+        perror (fname);
+        fprintf (stderr, "Unable to open %s for input\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+    m->len = (size_t) st.st_size;
+    if (m->len < BIGGUY_MAP_HDRSIZE) {
+        fprintf (stderr, "%s is not a bigguy file\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+
+    m->base = mmap ((void *) NULL, m->len, PROT_READ, MAP_SHARED, fd, 0);
+    if (m->base == MAP_FAILED) {
+        perror (fname);
+        fprintf (stderr, "Unable to map %s\n", fname);
+        m->base = (void *) NULL;
+        rval = 1; goto CLEANUP;
+    }
+
+    p = (const char *) m->base;
+    if (!map_header_ok ((const bigguy_map_hdr *) p, fname, m->len)) {
+        rval = 1; goto CLEANUP;
+    }
+    m->n = (int) ((const bigguy_map_hdr *) p)->n;
+    m->x = (const CCbigguy *) (p + BIGGUY_MAP_HDRSIZE);
+
+    if (verify) {
+        memcpy (&sum, p + m->len - 8, sizeof (sum));
+        if (map_checksum (m->x, (unsigned long long) m->n) != sum) {
+            fprintf (stderr, "Checksum error in %s\n", fname);
+            rval = 1; goto CLEANUP;
+        }
+    }
+
+CLEANUP:
+    if (fd != -1) close (fd);
+    if (rval) CCbigguy_map_close (m);
+    return rval;
+}
+
+void CCbigguy_map_close (CCbigguy_map *m)
+{
+    if (m->base) munmap (m->base, m->len);
+    m->x = (const CCbigguy *) NULL;
+    m->n = 0;
+    m->base = (void *) NULL;
+    m->len = 0;
+}
+
+#else  /* CC_BIGGUY_NOMMAP */
+
+int CCbigguy_map_open (CCbigguy_map *m, const char *fname, int verify)
+{
+    int rval = 0;
+    FILE *in = (FILE *) NULL;
+    bigguy_map_hdr h;
+    long len;
+    char *p;
+    unsigned long long sum;
+
+    m->x = (const CCbigguy *) NULL;
+    m->n = 0;
+    m->base = (void *) NULL;
+    m->len = 0;
+
+    in = fopen (fname, "rb");
+    if (!in || fseek (in, 0L, SEEK_END) || (len = ftell (in)) < 0 ||
+        fseek (in, 0L, SEEK_SET)) {
+        perror (fname);
+        fprintf (stderr, "Unable to open %s for input\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+    if (fread (&h, sizeof (h), 1, in) != 1 ||
+        !map_header_ok (&h, fname, (size_t) len)) {
+        rval = 1; goto CLEANUP;
+    }
+
+    m->len = (size_t) len;
+    p = CC_SAFE_MALLOC (m->len, char);
+    if (!p) {
+        fprintf (stderr, "out of memory in CCbigguy_map_open\n");
+        rval = 1; goto CLEANUP;
+    }
+    m->base = (void *) p;
+    memcpy (p, &h, sizeof (h));
+    if (fread (p + sizeof (h), 1, m->len - sizeof (h), in) !=
+        m->len - sizeof (h)) {
+        perror (fname);
+        fprintf (stderr, "Unable to read %s\n", fname);
+        rval = 1; goto CLEANUP;
+    }
+    m->n = (int) h.n;
+    m->x = (const CCbigguy *) (p + BIGGUY_MAP_HDRSIZE);
+
+    if (verify) {
+        memcpy (&sum, p + m->len - 8, sizeof (sum));
+        if (map_checksum (m->x, (unsigned long long) m->n) != sum) {
+            fprintf (stderr, "Checksum error in %s\n", fname);
+            rval = 1; goto CLEANUP;
+        }
+    }
+
+CLEANUP:
+    if (in) fclose (in);
+    if (rval) CCbigguy_map_close (m);
+    return rval;
+}
+
+void CCbigguy_map_close (CCbigguy_map *m)
+{
+    CC_IFFREE (m->base, void);
+    m->x = (const CCbigguy *) NULL;
+    m->n = 0;
+    m->len = 0;
+}
+
+#endif /* CC_BIGGUY_NOMMAP */
@@ -0,0 +1,401 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  MULTIPLYING AND DIVIDING BIGGUYS                                        */
+/*                                                                          */
+/*  The product of two bigguys has 128 fraction bits; it is formed exactly  */
+/*  in 256 bits (four 64-bit limbs, each a 64x64 multiply) and rounded      */
+/*  once to a multiple of 2^-64, after adding in x for                      */
+/*  CCbigguy_addmult_bigguy.  The round argument is one of                  */
+/*                                                                          */
+/*      CCbigguy_ROUND_FLOOR    toward -infinity                            */
+/*      CCbigguy_ROUND_CEIL     toward +infinity                            */
+/*      CCbigguy_ROUND_TRUNC    toward zero                                 */
+/*      CCbigguy_ROUND_NEAREST  to the nearest, ties to even                */
+/*                                                                          */
+/*  and the result is exact whenever it is a multiple of 2^-64.             */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  void CCbigguy_mul (CCbigguy *x, CCbigguy y, int round)                  */
+/*    x = x*y, rounded.                                                     */
+/*                                                                          */
+/*  void CCbigguy_addmult_bigguy (CCbigguy *x, CCbigguy y, CCbigguy z,      */
+/*      int round)                                                          */
+/*    x = x + y*z, with the sum rounded (so it is exact if y*z is).         */
+/*                                                                          */
+/*  void CCbigguy_mul_double (CCbigguy *x, double d, int round)             */
+/*    x = x*d, rounded.  Every double is a multiple of a power of 2, so     */
+/*    this is exact like the others.                                       */
+/*                                                                          */
+/*  void CCbigguy_divint (CCbigguy *x, int d, int round)                    */
+/*    x = x/d, rounded.                                                     */
+/*                                                                          */
+/*    If an overflow occurs (or d is 0, or d is an infinity or NaN), an     */
+/*    error message is output and the routines abort.                       */
+/*                                                                          */
+/*  int CCbigguy_mul_chk (CCbigguy *x, CCbigguy y, int round)               */
+/*  int CCbigguy_addmult_bigguy_chk (CCbigguy *x, CCbigguy y, CCbigguy z,   */
+/*      int round)                                                          */
+/*  int CCbigguy_mul_double_chk (CCbigguy *x, double d, int round)          */
+/*  int CCbigguy_divint_chk (CCbigguy *x, int d, int round)                 */
+/*    Non-aborting versions of the above.  They return 0, or 1 if the       */
+/*    result overflows (or d is 0, or not finite), in which case x is left  */
+/*    unchanged.                                                            */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define HIBIT (1ULL << 63)
+
+static int
+    mul_add (CCbigguy *x, CCbigguy y, CCbigguy z, int round, int add),
+    narrow (const unsigned long long *s, int round, CCbigguy *x),
+    any_bits (const unsigned long long *p, int n, int pos, int above);
+
+static unsigned long long
+    window (const unsigned long long *p, int n, int pos);
+
+static void
+    mul_mag (const unsigned long long *a, const unsigned long long *b,
+        unsigned long long *p),
+    neg_limbs (unsigned long long *s, int n, int neg);
+
+
+/* a*b = (hi:lo) */
+
+#ifdef __SIZEOF_INT128__
+
+static inline unsigned long long umul64 (unsigned long long a,
+        unsigned long long b, unsigned long long *hi)
+{
+    unsigned __int128 p = (unsigned __int128) a * b;
+
+    *hi = (unsigned long long) (p >> 64);
+    return (unsigned long long) p;
+}
+
+#else
+
+static inline unsigned long long umul64 (unsigned long long a,
+        unsigned long long b, unsigned long long *hi)
+{
+    unsigned long long a0 = a & 0xffffffffULL, a1 = a >> 32;
+    unsigned long long b0 = b & 0xffffffffULL, b1 = b >> 32;
+    unsigned long long p00 = a0 * b0, p01 = a0 * b1;
+    unsigned long long p10 = a1 * b0, p11 = a1 * b1;
+    unsigned long long mid = (p00 >> 32) + (p01 & 0xffffffffULL) +
+                             (p10 & 0xffffffffULL);
+
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xffffffffULL);
+}
+
+#endif
+
+/* x as two's complement limbs s[0] (low) and s[1]; returns the sign */
+
+static inline int load_limbs (CCbigguy x, unsigned long long *s)
+{
+    s[0] = ((unsigned long long) x.fhi << 32) | x.flo;
+    s[1] = ((unsigned long long) x.ihi << 32) | x.ilo;
+    return (int) (s[1] >> 63);
+}
+
+/* s = -s if neg; no branches, since the signs are unpredictable */
+
+static void neg_limbs (unsigned long long *s, int n, int neg)
+{
+    unsigned long long mask = 0 - (unsigned long long) neg;
+    unsigned long long c = (unsigned long long) neg;
+    int i;
+
+    for (i = 0; i < n; i++) {
+        s[i] = (s[i] ^ mask) + c;
+        c &= (s[i] == 0);
+    }
+}
+
+/* p[0..3] = a*b, for 128-bit magnitudes a and b */
+
+static void mul_mag (const unsigned long long *a, const unsigned long long *b,
+        unsigned long long *p)
+{
+    unsigned long long h00, h01, h10, h11, l01, l10, l11, t;
+    int c;
+
+    p[0] = umul64 (a[0], b[0], &h00);
+    l01 = umul64 (a[0], b[1], &h01);
+    l10 = umul64 (a[1], b[0], &h10);
+    l11 = umul64 (a[1], b[1], &h11);
+
+    t = h00 + l01;
+    c = (t < h00);
+    p[1] = t + l10;
+    c += (p[1] < t);
+
+    t = h01 + h10;
+    p[3] = h11 + (t < h01);
+    p[2] = t + l11;
+    p[3] += (p[2] < t);
+    t = p[2];
+    p[2] += (unsigned long long) c;
+    p[3] += (p[2] < t);
+}
+
+/* x = s rounded, for s a signed 256-bit multiple of 2^-128 (s[0] the  */
+/* low limb); returns 1, leaving x alone, if the result does not fit  */
+
+static int narrow (const unsigned long long *s, int round, CCbigguy *x)
+{
+    unsigned long long r = s[0], q0 = s[1], q1 = s[2], q2 = s[3];
+    int up;
+
+    /* q = floor (s), and r/2^64 is what it dropped */
+    switch (round) {
+    case CCbigguy_ROUND_FLOOR:
+        up = 0;
+        break;
+    case CCbigguy_ROUND_CEIL:
+        up = (r != 0);
+        break;
+    case CCbigguy_ROUND_TRUNC:
+        up = (r != 0) && (q2 >> 63);
+        break;
+    default:
+        up = (r > HIBIT) || (r == HIBIT && (q0 & 1));
+        break;
+    }
+    q0 += (unsigned long long) up;
+    q1 += (q0 < (unsigned long long) up);
+    q2 += (q1 == 0 && q0 == 0 && up);
+
+    if (q2 != ((q1 >> 63) ? ~0ULL : 0ULL)) return 1;
+
+    x->ihi = (unsigned int) (q1 >> 32);
+    x->ilo = (unsigned int) q1;
+    x->fhi = (unsigned int) (q0 >> 32);
+    x->flo = (unsigned int) q0;
+    return 0;
+}
+
+/* x = (add ? x : 0) + y*z */
+
+static int mul_add (CCbigguy *x, CCbigguy y, CCbigguy z, int round, int add)
+{
+    unsigned long long a[2], b[2], p[4], s[4], t;
+    int sa, sb, c, i;
+
+    sa = load_limbs (y, a);
+    sb = load_limbs (z, b);
+    neg_limbs (a, 2, sa);
+    neg_limbs (b, 2, sb);
+    mul_mag (a, b, p);
+    neg_limbs (p, 4, sa ^ sb);
+
+    if (!add) return narrow (p, round, x);
+
+    /* s = x*2^64, a multiple of 2^-128 like p */
+    s[0] = 0;
+    load_limbs (*x, s + 1);
+    s[3] = (s[2] >> 63) ? ~0ULL : 0ULL;
+    for (i = 0, c = 0; i < 4; i++) {
+        t = s[i] + p[i];
+        s[i] = t + (unsigned long long) c;
+        c = (t < p[i]) || (s[i] < t);
+    }
+    return narrow (s, round, x);
+}
+
+int CCbigguy_mul_chk (CCbigguy *x, CCbigguy y, int round)
+{
+    return mul_add (x, *x, y, round, 0);
+}
+
+int CCbigguy_addmult_bigguy_chk (CCbigguy *x, CCbigguy y, CCbigguy z,
+        int round)
+{
+    return mul_add (x, y, z, round, 1);
+}
+
+/* the 64 bits of p[0..n-1] from bit pos up (those outside p are 0) */
+
+static unsigned long long window (const unsigned long long *p, int n, int pos)
+{
+    unsigned long long w;
+    int j, b;
+
+    if (pos <= -64 || pos >= 64 * n) return 0;
+    if (pos < 0) return p[0] << -pos;
+    j = pos / 64;
+    b = pos % 64;
+    w = p[j] >> b;
+    if (b && j + 1 < n) w |= p[j+1] << (64 - b);
+    return w;
+}
+
+/* whether p[0..n-1] has a 1 below bit pos (above it, if above) */
+
+static int any_bits (const unsigned long long *p, int n, int pos, int above)
+{
+    int j, lo, hi;
+
+    for (j = 0; j < n; j++) {
+        lo = 64 * j;
+        hi = lo + 64;
+        if (above ? (lo >= pos) : (hi <= pos)) {
+            if (p[j]) return 1;
+        } else if (lo < pos && pos < hi) {
+            if (above ? (p[j] >> (pos - lo))
+                      : (p[j] & ((1ULL << (pos - lo)) - 1))) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int CCbigguy_mul_double_chk (CCbigguy *x, double d, int round)
+{
+    unsigned long long bits, m, t, a[2], p[3], s[4];
+    int e, k, i, neg, sa;
+
+    memcpy (&bits, &d, sizeof (bits));
+    e = (int) ((bits >> 52) & 0x7ff);
+    if (e == 0x7ff) return 1;
+
+    /* |d| = m * 2^e */
+    m = bits & ((1ULL << 52) - 1);
+    if (e) m |= 1ULL << 52;
+    else   e = 1;
+    e -= 1075;
+    neg = (int) (bits >> 63);
+
+    /* p = |x| * m, in units of 2^-64 */
+    sa = load_limbs (*x, a);
+    neg_limbs (a, 2, sa);
+    neg ^= sa;
+    p[0] = umul64 (a[0], m, &p[1]);
+    t = umul64 (a[1], m, &p[2]);
+    p[1] += t;
+    p[2] += (p[1] < t);
+
+    /* s = p * 2^(64+e), in units of 2^-128; the bits shifted out at */
+    /* the bottom only matter as a sticky bit, and none may be       */
+    /* shifted into the sign bit or beyond                           */
+    k = 64 + e;
+    if (any_bits (p, 3, 255 - k, 1)) return 1;
+    for (i = 0; i < 4; i++) s[i] = window (p, 3, 64 * i - k);
+    if (k < 0 && any_bits (p, 3, -k, 0)) s[0] |= 1;
+
+    neg_limbs (s, 4, neg);
+    return narrow (s, round, x);
+}
+
+int CCbigguy_divint_chk (CCbigguy *x, int d, int round)
+{
+    unsigned long long a[2], q[2], rem, dm;
+    unsigned int l[4];
+    int neg, i, up;
+
+    if (d == 0) return 1;
+    neg = load_limbs (*x, a);
+    neg_limbs (a, 2, neg);
+    dm = (d < 0) ? 0 - (unsigned long long) (long long) d
+                 : (unsigned long long) d;
+    if (d < 0) neg = !neg;
+
+    /* long division a 32-bit limb at a time; rem < dm <= 2^31 */
+    l[0] = (unsigned int) (a[1] >> 32);
+    l[1] = (unsigned int) a[1];
+    l[2] = (unsigned int) (a[0] >> 32);
+    l[3] = (unsigned int) a[0];
+    rem = 0;
+    for (i = 0; i < 4; i++) {
+        rem = (rem << 32) | l[i];
+        l[i] = (unsigned int) (rem / dm);
+        rem %= dm;
+    }
+    q[1] = ((unsigned long long) l[0] << 32) | l[1];
+    q[0] = ((unsigned long long) l[2] << 32) | l[3];
+
+    /* round the magnitude, with neg the sign of x/d */
+    switch (round) {
+    case CCbigguy_ROUND_FLOOR:
+        up = neg && rem;
+        break;
+    case CCbigguy_ROUND_CEIL:
+        up = !neg && rem;
+        break;
+    case CCbigguy_ROUND_TRUNC:
+        up = 0;
+        break;
+    default:
+        up = (2 * rem > dm) || (2 * rem == dm && (q[0] & 1));
+        break;
+    }
+    q[0] += (unsigned long long) up;
+    q[1] += (q[0] == 0 && up);
+
+    /* |x/d| <= |x| <= 2^127, and only -2^127 has that magnitude */
+    if (q[1] >> 63) {
+        if (!neg || q[1] != HIBIT || q[0]) return 1;
+    }
+    neg_limbs (q, 2, neg);
+
+    x->ihi = (unsigned int) (q[1] >> 32);
+    x->ilo = (unsigned int) q[1];
+    x->fhi = (unsigned int) (q[0] >> 32);
+    x->flo = (unsigned int) q[0];
+    return 0;
+}
+
+void CCbigguy_mul (CCbigguy *x, CCbigguy y, int round)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_mul_chk (x, y, round))) {
+        CCbigguy_overflow ("CCbigguy_mul");
+    }
+}
+
+void CCbigguy_addmult_bigguy (CCbigguy *x, CCbigguy y, CCbigguy z,
+        int round)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_addmult_bigguy_chk (x, y, z, round))) {
+        CCbigguy_overflow ("CCbigguy_addmult_bigguy");
+    }
+}
+
+void CCbigguy_mul_double (CCbigguy *x, double d, int round)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_mul_double_chk (x, d, round))) {
+        CCbigguy_overflow ("CCbigguy_mul_double");
+    }
+}
+
+void CCbigguy_divint (CCbigguy *x, int d, int round)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_divint_chk (x, d, round))) {
+        CCbigguy_overflow ("CCbigguy_divint");
+    }
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
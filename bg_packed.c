@@ -0,0 +1,338 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  PACKED BIGGUY ARRAYS                                                    */
+/*                                                                          */
+/*  A CCbigguy_packed stores n bigguys in 8 or 12 bytes each.  A value      */
+/*  fits if ihi is just the sign of ilo (the integer part is a 32-bit int)  */
+/*  and, for width 8, flo is 0.  The array mid holds ilo:fhi of each value  */
+/*  that fits, and lo its flo (width 12 only).  Values that do not fit, and */
+/*  those with ilo 0x80000000, go to the escape table esc: their mid word   */
+/*  is 0x80000000 in the high half and the index into esc in the low half.  */
+/*                                                                          */
+/*  The bulk kernels stream mid (and lo) without branches, giving the       */
+/*  escaped slots weight 0, and then visit the escaped slots of a chunk     */
+/*  only if it had any.  The sums are exact, as in bg_wide.c.               */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_packed_init (CCbigguy_packed *p, int n, int width)         */
+/*    Allocates an array of n zeros, width (8 or 12) bytes each.  Returns   */
+/*    0 on success, 1 if out of memory (or n < 0, or width is neither).     */
+/*                                                                          */
+/*  void CCbigguy_packed_free (CCbigguy_packed *p)                          */
+/*                                                                          */
+/*  CCbigguy CCbigguy_packed_get (const CCbigguy_packed *p, int i)          */
+/*    Returns p[i].                                                         */
+/*                                                                          */
+/*  int CCbigguy_packed_set (CCbigguy_packed *p, int i, CCbigguy x)         */
+/*    Sets p[i] = x.  Returns 1 (changing nothing) if x needs a new escape  */
+/*    entry and there is no memory for it, and 0 otherwise.  An escaped     */
+/*    slot reuses its entry; entries of slots later set to values that fit  */
+/*    are only released by CCbigguy_packed_free.                            */
+/*                                                                          */
+/*  int CCbigguy_packed_sum_chk (CCbigguy *acc, const CCbigguy_packed *y)   */
+/*    acc += y[0] + ... + y[n-1].                                           */
+/*                                                                          */
+/*  int CCbigguy_packed_dot_chk (CCbigguy *acc, const CCbigguy_packed *y,   */
+/*      const int *m)                                                       */
+/*    acc += y[0]*m[0] + ... + y[n-1]*m[n-1].                               */
+/*                                                                          */
+/*    These two return 1 (leaving acc unchanged) if the final sum           */
+/*    overflows, and 0 otherwise.                                           */
+/*                                                                          */
+/*  void CCbigguy_packed_cmp (const CCbigguy_packed *x, CCbigguy y,         */
+/*      int *cmp)                                                           */
+/*    cmp[i] = CCbigguy_cmp (x[i], y).                                      */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define PACKED_ESC   0x80000000u
+#define PACKED_CHUNK (1 << 28)        /* terms between folds of the lanes */
+#define PACKED_ISESC(w) ((unsigned int) ((w) >> 32) == PACKED_ESC)
+
+static int
+    packed_fits (CCbigguy x, int width),
+    packed_grow (CCbigguy_packed *p),
+    packed_chunk (const CCbigguy_packed *y, const int *m, int i, int stop,
+        long long *l),
+    packed_dot (CCbigguy *acc, const CCbigguy_packed *y, const int *m);
+
+
+static int packed_fits (CCbigguy x, int width)
+{
+    return x.ihi == 0 - (x.ilo >> 31) && x.ilo != PACKED_ESC &&
+           (width == 12 || x.flo == 0);
+}
+
+static int packed_grow (CCbigguy_packed *p)
+{
+    int space = p->escspace ? 2 * p->escspace : 16;
+
+    if (p->escspace >= (1 << 30)) return 1;
+    if (CCutil_reallocrus_count ((void **) &p->esc, space,
+                                 sizeof (CCbigguy))) {
+        return 1;
+    }
+    p->escspace = space;
+    return 0;
+}
+
+/* Sets l[0..5] to the lanes (as in bg_wide.c) of y[i..stop-1] times    */
+/* m[i..stop-1] (times 1 if m is NULL), skipping the escaped slots, and  */
+/* returns 1 if there were any.  With __int128, the mid and lo words     */
+/* are summed as smid and slo, and the lanes are 2^32*smid + slo.        */
+
+#ifdef __SIZEOF_INT128__
+
+static int packed_chunk (const CCbigguy_packed *y, const int *m, int i,
+        int stop, long long *l)
+{
+    __int128 smid = 0, slo = 0;
+    long long v, mk;
+    int k, esc, anyesc = 0;
+
+    if (m && y->lo) {
+        for (k = i; k < stop; k++) {
+            v = (long long) y->mid[k];
+            esc = PACKED_ISESC (v);
+            anyesc |= esc;
+            mk = (long long) m[k] & ((long long) esc - 1);
+            smid += (__int128) v * mk;
+            slo += (long long) y->lo[k] * mk;
+        }
+    } else if (m) {
+        for (k = i; k < stop; k++) {
+            v = (long long) y->mid[k];
+            esc = PACKED_ISESC (v);
+            anyesc |= esc;
+            mk = (long long) m[k] & ((long long) esc - 1);
+            smid += (__int128) v * mk;
+        }
+    } else {
+        for (k = i; k < stop; k++) {
+            v = (long long) y->mid[k];
+            esc = PACKED_ISESC (v);
+            anyesc |= esc;
+            smid += v & ((long long) esc - 1);
+        }
+        if (y->lo) {
+            for (k = i; k < stop; k++) slo += y->lo[k];
+        }
+    }
+
+    for (k = 0; k < 3; k++) {
+        l[k] = (long long) (slo & 0xffffffff);
+        slo >>= 32;
+    }
+    l[3] = (long long) slo;
+    for (k = 1; k < 4; k++) {
+        l[k] += (long long) (smid & 0xffffffff);
+        smid >>= 32;
+    }
+    l[4] = (long long) smid;
+    l[5] = 0;
+    return anyesc;
+}
+
+#else  /* __SIZEOF_INT128__ */
+
+static int packed_chunk (const CCbigguy_packed *y, const int *m, int i,
+        int stop, long long *l)
+{
+    unsigned long long v;
+    long long p, mk;
+    int k, esc, anyesc = 0;
+
+    for (k = 0; k < 6; k++) l[k] = 0;
+
+    for (k = i; k < stop; k++) {
+        v = y->mid[k];
+        esc = PACKED_ISESC (v);
+        anyesc |= esc;
+        mk = (m ? (long long) m[k] : 1LL) & ((long long) esc - 1);
+        p = (long long) (unsigned int) v * mk;
+        l[1] += p & 0xffffffff;
+        l[2] += p >> 32;
+        p = (long long) (int) (unsigned int) (v >> 32) * mk;
+        l[2] += p & 0xffffffff;
+        l[3] += p >> 32;
+    }
+    if (y->lo) {
+        for (k = i; k < stop; k++) {
+            p = (long long) y->lo[k] * (m ? m[k] : 1);
+            l[0] += p & 0xffffffff;
+            l[1] += p >> 32;
+        }
+    }
+    return anyesc;
+}
+
+#endif /* __SIZEOF_INT128__ */
+
+static int packed_dot (CCbigguy *acc, const CCbigguy_packed *y, const int *m)
+{
+    CCbigguy_wide w, v;
+    int i, k, stop;
+
+    CCbigguy_wide_init (&w, *acc);
+
+    for (i = 0; i < y->n; i = stop) {
+        stop = (y->n - i > PACKED_CHUNK) ? i + PACKED_CHUNK : y->n;
+        v.pending = 0;
+        if (packed_chunk (y, m, i, stop, v.lane)) {
+            for (k = i; k < stop; k++) {
+                if (PACKED_ISESC (y->mid[k])) {
+                    CCbigguy_wide_addmult (&w,
+                              &y->esc[(unsigned int) y->mid[k]],
+                              m ? m[k] : 1);
+                }
+            }
+        }
+        CCbigguy_wide_merge (&w, &v);
+    }
+
+    return CCbigguy_wide_narrow (&w, acc);
+}
+
+int CCbigguy_packed_init (CCbigguy_packed *p, int n, int width)
+{
+    p->n = 0;
+    p->width = width;
+    p->mid = (unsigned long long *) NULL;
+    p->lo = (unsigned int *) NULL;
+    p->esc = (CCbigguy *) NULL;
+    p->nesc = 0;
+    p->escspace = 0;
+
+    if (n < 0 || (width != 8 && width != 12)) return 1;
+    p->mid = CC_SAFE_MALLOC (n > 0 ? n : 1, unsigned long long);
+    if (!p->mid) return 1;
+    memset (p->mid, 0, (size_t) n * sizeof (unsigned long long));
+    if (width == 12) {
+        p->lo = CC_SAFE_MALLOC (n > 0 ? n : 1, unsigned int);
+        if (!p->lo) {
+            CC_FREE (p->mid, unsigned long long);
+            return 1;
+        }
+        memset (p->lo, 0, (size_t) n * sizeof (unsigned int));
+    }
+    p->n = n;
+    return 0;
+}
+
+void CCbigguy_packed_free (CCbigguy_packed *p)
+{
+    CC_IFFREE (p->mid, unsigned long long);
+    CC_IFFREE (p->lo, unsigned int);
+    CC_IFFREE (p->esc, CCbigguy);
+    p->n = 0;
+    p->nesc = 0;
+    p->escspace = 0;
+}
+
+CCbigguy CCbigguy_packed_get (const CCbigguy_packed *p, int i)
+{
+    unsigned long long w = p->mid[i];
+    CCbigguy x;
+
+    if (CCbigguy_UNLIKELY (PACKED_ISESC (w))) return p->esc[(unsigned int) w];
+
+    x.ilo = (unsigned int) (w >> 32);
+    x.ihi = 0 - (x.ilo >> 31);
+    x.fhi = (unsigned int) w;
+    x.flo = p->lo ? p->lo[i] : 0;
+    return x;
+}
+
+int CCbigguy_packed_set (CCbigguy_packed *p, int i, CCbigguy x)
+{
+    unsigned long long w = p->mid[i];
+    unsigned int k;
+
+    if (packed_fits (x, p->width)) {
+        p->mid[i] = ((unsigned long long) x.ilo << 32) | x.fhi;
+        if (p->lo) p->lo[i] = x.flo;
+        return 0;
+    }
+
+    if (PACKED_ISESC (w)) {
+        k = (unsigned int) w;
+    } else {
+        if (p->nesc == p->escspace && packed_grow (p)) return 1;
+        k = (unsigned int) p->nesc++;
+    }
+    p->esc[k] = x;
+    p->mid[i] = ((unsigned long long) PACKED_ESC << 32) | k;
+    if (p->lo) p->lo[i] = 0;
+    return 0;
+}
+
+int CCbigguy_packed_sum_chk (CCbigguy *acc, const CCbigguy_packed *y)
+{
+    return packed_dot (acc, y, (const int *) NULL);
+}
+
+int CCbigguy_packed_dot_chk (CCbigguy *acc, const CCbigguy_packed *y,
+        const int *m)
+{
+    return packed_dot (acc, y, m);
+}
+
+/* y is compared as ym:yl, ym = ilo:fhi signed; if y is outside the */
+/* range of the packed values, they all compare the same way.       */
+
+void CCbigguy_packed_cmp (const CCbigguy_packed *x, CCbigguy y, int *cmp)
+{
+    long long ym, a;
+    unsigned int yl, l;
+    int i, c, anyesc = 0;
+
+    if (y.ihi != 0 - (y.ilo >> 31)) {
+        c = (y.ihi >> 31) ? 1 : -1;
+        for (i = 0; i < x->n; i++) {
+            cmp[i] = c;
+            anyesc |= PACKED_ISESC (x->mid[i]);
+        }
+    } else {
+        ym = (long long) (((unsigned long long) y.ilo << 32) | y.fhi);
+        yl = y.flo;
+        for (i = 0; i < x->n; i++) {
+            a = (long long) x->mid[i];
+            l = x->lo ? x->lo[i] : 0;
+            anyesc |= PACKED_ISESC (x->mid[i]);
+            c = 2 * ((a > ym) - (a < ym)) + ((l > yl) - (l < yl));
+            cmp[i] = (c > 0) - (c < 0);
+        }
+    }
+
+    if (anyesc) {
+        for (i = 0; i < x->n; i++) {
+            if (PACKED_ISESC (x->mid[i])) {
+                cmp[i] = CCbigguy_cmp (x->esc[(unsigned int) x->mid[i]], y);
+            }
+        }
+    }
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,186 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  PARALLEL BIGGUY REDUCTIONS                                              */
+/*                                                                          */
+/*  The array is cut into one block per thread of the pool (blocks are at   */
+/*  least BIGGUY_PAR_MINBLOCK long, so short arrays use fewer threads),     */
+/*  each block is summed into its own CCbigguy_wide, and the partial sums   */
+/*  are merged in block order and narrowed once.  The partial sums sit on   */
+/*  separate cache lines, so the threads do not share lines while they      */
+/*  run.  Since the wide sums are exact, the result (and whether it         */
+/*  overflows) is the same as for the serial CCbigguy_dot, for any number   */
+/*  of threads and any scheduling: intermediate sums may go out of range,   */
+/*  and only the final sum is checked.                                      */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_par_sum_chk (CCbigguy_pool *pool, CCbigguy *acc,           */
+/*      const CCbigguy *y, int n)                                           */
+/*    acc += y[0] + ... + y[n-1].                                           */
+/*                                                                          */
+/*  int CCbigguy_par_dot_chk (CCbigguy_pool *pool, CCbigguy *acc,           */
+/*      const CCbigguy *y, const int *m, int n)                             */
+/*    acc += y[0]*m[0] + ... + y[n-1]*m[n-1].                               */
+/*                                                                          */
+/*  int CCbigguy_par_dot_sparse_chk (CCbigguy_pool *pool, CCbigguy *acc,    */
+/*      const CCbigguy *y, const int *ind, const int *m, int n)             */
+/*    acc += y[ind[0]]*m[0] + ... + y[ind[n-1]]*m[n-1].                     */
+/*                                                                          */
+/*    The three return 1 (leaving acc unchanged) if the final sum           */
+/*    overflows, and 0 otherwise.                                           */
+/*                                                                          */
+/*  void CCbigguy_par_sum (CCbigguy_pool *pool, CCbigguy *acc,              */
+/*      const CCbigguy *y, int n)                                           */
+/*  void CCbigguy_par_dot (CCbigguy_pool *pool, CCbigguy *acc,              */
+/*      const CCbigguy *y, const int *m, int n)                             */
+/*  void CCbigguy_par_dot_sparse (CCbigguy_pool *pool, CCbigguy *acc,       */
+/*      const CCbigguy *y, const int *ind, const int *m, int n)             */
+/*    As above, but if the final sum overflows, an error message is         */
+/*    output and the routine aborts.                                        */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define BIGGUY_PAR_MINBLOCK 4096
+#define BIGGUY_PAR_MAXBLOCKS 64
+#define BIGGUY_PAR_LINE 64
+
+typedef union bigguy_par_part {
+    CCbigguy_wide w;
+    char line[BIGGUY_PAR_LINE * ((sizeof (CCbigguy_wide) +
+                                  BIGGUY_PAR_LINE - 1) / BIGGUY_PAR_LINE)];
+} bigguy_par_part;
+
+typedef struct bigguy_par_job {
+    const CCbigguy *y;
+    const int *ind;
+    const int *m;
+    int n;
+    int nblocks;
+    bigguy_par_part *part;
+} bigguy_par_job;
+
+static void
+    par_block (void *arg, int b);
+
+static int
+    par_reduce (CCbigguy_pool *pool, CCbigguy *acc, const CCbigguy *y,
+        const int *ind, const int *m, int n);
+
+
+static void par_block (void *arg, int b)
+{
+    bigguy_par_job *job = (bigguy_par_job *) arg;
+    CCbigguy_wide *w = &job->part[b].w;
+    int lo = (int) ((long long) job->n * b / job->nblocks);
+    int hi = (int) ((long long) job->n * (b + 1) / job->nblocks);
+
+    CCbigguy_wide_init (w, CCbigguy_ZERO);
+    if (!job->m) {
+        CCbigguy_wide_sum (w, job->y + lo, hi - lo);
+    } else if (!job->ind) {
+        CCbigguy_wide_dot (w, job->y + lo, job->m + lo, hi - lo);
+    } else {
+        CCbigguy_wide_dot_sparse (w, job->y, job->ind + lo, job->m + lo,
+                                  hi - lo);
+    }
+}
+
+static int par_reduce (CCbigguy_pool *pool, CCbigguy *acc, const CCbigguy *y,
+        const int *ind, const int *m, int n)
+{
+    char space[(BIGGUY_PAR_MAXBLOCKS + 1) * sizeof (bigguy_par_part)];
+    bigguy_par_job job;
+    CCbigguy_wide w;
+    size_t a;
+    int b;
+
+    job.y = y;
+    job.ind = ind;
+    job.m = m;
+    job.n = n;
+    job.nblocks = CCbigguy_pool_nthreads (pool);
+    if (job.nblocks > n / BIGGUY_PAR_MINBLOCK) {
+        job.nblocks = n / BIGGUY_PAR_MINBLOCK;
+    }
+    if (job.nblocks > BIGGUY_PAR_MAXBLOCKS) job.nblocks = BIGGUY_PAR_MAXBLOCKS;
+    if (job.nblocks < 1) job.nblocks = 1;
+
+    a = (size_t) space;
+    a = (a + BIGGUY_PAR_LINE - 1) & ~((size_t) BIGGUY_PAR_LINE - 1);
+    job.part = (bigguy_par_part *) a;
+
+    CCbigguy_pool_run (pool, job.nblocks, par_block, &job);
+
+    CCbigguy_wide_init (&w, *acc);
+    for (b = 0; b < job.nblocks; b++) {
+        CCbigguy_wide_merge (&w, &job.part[b].w);
+    }
+    return CCbigguy_wide_narrow (&w, acc);
+}
+
+int CCbigguy_par_sum_chk (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, int n)
+{
+    return par_reduce (pool, acc, y, (const int *) NULL, (const int *) NULL,
+                       n);
+}
+
+int CCbigguy_par_dot_chk (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *m, int n)
+{
+    return par_reduce (pool, acc, y, (const int *) NULL, m, n);
+}
+
+int CCbigguy_par_dot_sparse_chk (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *ind, const int *m, int n)
+{
+    return par_reduce (pool, acc, y, ind, m, n);
+}
+
+void CCbigguy_par_sum (CCbigguy_pool *pool, CCbigguy *acc, const CCbigguy *y,
+        int n)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_par_sum_chk (pool, acc, y, n))) {
+        CCbigguy_overflow ("CCbigguy_par_sum");
+    }
+}
+
+void CCbigguy_par_dot (CCbigguy_pool *pool, CCbigguy *acc, const CCbigguy *y,
+        const int *m, int n)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_par_dot_chk (pool, acc, y, m, n))) {
+        CCbigguy_overflow ("CCbigguy_par_dot");
+    }
+}
+
+void CCbigguy_par_dot_sparse (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *ind, const int *m, int n)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_par_dot_sparse_chk (pool, acc, y, ind, m,
+                                                        n))) {
+        CCbigguy_overflow ("CCbigguy_par_dot_sparse");
+    }
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,240 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  BIGGUY THREAD POOLS                                                     */
+/*                                                                          */
+/*  A CCbigguy_pool is a fixed set of worker threads that run the tasks     */
+/*  0..ntasks-1 of one job at a time, with the calling thread taking tasks  */
+/*  as well.  Tasks are handed out in order from a shared counter, so       */
+/*  which thread runs a task depends on the scheduling; the parallel        */
+/*  bigguy routines therefore give each task its own output and combine     */
+/*  the outputs in task order.  Threads are only used if CC_POSIXTHREADS    */
+/*  is defined; otherwise a pool runs every task in the calling thread.     */
+/*  A NULL pool may be passed wherever a pool is expected, and also runs    */
+/*  everything in the calling thread.                                       */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_pool_init (CCbigguy_pool **pool, int nthreads)             */
+/*    Starts a pool of nthreads threads, counting the caller (so            */
+/*    nthreads - 1 workers), or one per online processor if nthreads is     */
+/*    0.  Returns 0 on success, 1 on failure.                               */
+/*                                                                          */
+/*  void CCbigguy_pool_free (CCbigguy_pool *pool)                           */
+/*    Stops and joins the workers.                                          */
+/*                                                                          */
+/*  int CCbigguy_pool_nthreads (const CCbigguy_pool *pool)                  */
+/*    The number of threads that run tasks, counting the caller.            */
+/*                                                                          */
+/*  void CCbigguy_pool_run (CCbigguy_pool *pool, int ntasks,                */
+/*      void (*task) (void *arg, int i), void *arg)                         */
+/*    Calls task (arg, i) for i = 0..ntasks-1 and returns when all have     */
+/*    finished.  Only one job may run on a pool at a time.                  */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifdef CC_POSIXTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define BIGGUY_POOL_MAXTHREADS 256
+
+struct CCbigguy_pool {
+    int nthreads;
+#ifdef CC_POSIXTHREADS
+    pthread_t *workers;
+    int nworkers;
+    pthread_mutex_t lock;
+    pthread_cond_t go;
+    pthread_cond_t done;
+    void (*task) (void *arg, int i);
+    void *arg;
+    int ntasks;
+    int next;
+    int finished;
+    unsigned long job;
+    int quit;
+#endif
+};
+
+#ifdef CC_POSIXTHREADS
+
+static void
+    pool_take_tasks (CCbigguy_pool *pool);
+
+static void
+    *pool_worker (void *arg);
+
+
+/* runs tasks of the current job until none are left; called and       */
+/* returns with the lock held                                           */
+
+static void pool_take_tasks (CCbigguy_pool *pool)
+{
+    void (*task) (void *arg, int i) = pool->task;
+    void *arg = pool->arg;
+    int i;
+
+    while (pool->next < pool->ntasks) {
+        i = pool->next++;
+        pthread_mutex_unlock (&pool->lock);
+        task (arg, i);
+        pthread_mutex_lock (&pool->lock);
+        if (++pool->finished == pool->ntasks) {
+            pthread_cond_signal (&pool->done);
+        }
+    }
+}
+
+static void *pool_worker (void *arg)
+{
+    CCbigguy_pool *pool = (CCbigguy_pool *) arg;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock (&pool->lock);
+    for (;;) {
+        while (pool->job == seen && !pool->quit) {
+            pthread_cond_wait (&pool->go, &pool->lock);
+        }
+        if (pool->quit) break;
+        seen = pool->job;
+        pool_take_tasks (pool);
+    }
+    pthread_mutex_unlock (&pool->lock);
+    return (void *) NULL;
+}
+
+int CCbigguy_pool_init (CCbigguy_pool **pool, int nthreads)
+{
+    CCbigguy_pool *p;
+    long ncpu;
+
+    *pool = (CCbigguy_pool *) NULL;
+    if (nthreads <= 0) {
+        ncpu = sysconf (_SC_NPROCESSORS_ONLN);
+        nthreads = (ncpu > 0) ? (int) ncpu : 1;
+    }
+    if (nthreads > BIGGUY_POOL_MAXTHREADS) nthreads = BIGGUY_POOL_MAXTHREADS;
+
+    p = CC_SAFE_MALLOC (1, CCbigguy_pool);
+    if (!p) return 1;
+    memset (p, 0, sizeof (CCbigguy_pool));
+    p->workers = CC_SAFE_MALLOC (nthreads, pthread_t);
+    if (!p->workers) {
+        CC_FREE (p, CCbigguy_pool);
+        return 1;
+    }
+    pthread_mutex_init (&p->lock, (pthread_mutexattr_t *) NULL);
+    pthread_cond_init (&p->go, (pthread_condattr_t *) NULL);
+    pthread_cond_init (&p->done, (pthread_condattr_t *) NULL);
+
+    /* if a worker cannot be started, run with the ones that were */
+    for (p->nworkers = 0; p->nworkers < nthreads - 1; p->nworkers++) {
+        if (pthread_create (&p->workers[p->nworkers],
+                            (pthread_attr_t *) NULL, pool_worker, p)) {
+            break;
+        }
+    }
+    p->nthreads = p->nworkers + 1;
+    *pool = p;
+    return 0;
+}
+
+void CCbigguy_pool_free (CCbigguy_pool *pool)
+{
+    int k;
+
+    if (!pool) return;
+    pthread_mutex_lock (&pool->lock);
+    pool->quit = 1;
+    pthread_cond_broadcast (&pool->go);
+    pthread_mutex_unlock (&pool->lock);
+    for (k = 0; k < pool->nworkers; k++) {
+        pthread_join (pool->workers[k], (void **) NULL);
+    }
+    pthread_cond_destroy (&pool->done);
+    pthread_cond_destroy (&pool->go);
+    pthread_mutex_destroy (&pool->lock);
+    CC_FREE (pool->workers, pthread_t);
+    CC_FREE (pool, CCbigguy_pool);
+}
+
+void CCbigguy_pool_run (CCbigguy_pool *pool, int ntasks,
+        void (*task) (void *arg, int i), void *arg)
+{
+    int i;
+
+    if (!pool || pool->nworkers == 0 || ntasks <= 1) {
+        for (i = 0; i < ntasks; i++) task (arg, i);
+        return;
+    }
+
+    pthread_mutex_lock (&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->ntasks = ntasks;
+    pool->next = 0;
+    pool->finished = 0;
+    pool->job++;
+    pthread_cond_broadcast (&pool->go);
+    pool_take_tasks (pool);
+    while (pool->finished < pool->ntasks) {
+        pthread_cond_wait (&pool->done, &pool->lock);
+    }
+    pthread_mutex_unlock (&pool->lock);
+}
+
+#else  /* CC_POSIXTHREADS */
+
+int CCbigguy_pool_init (CCbigguy_pool **pool, int nthreads)
+{
+    CCbigguy_pool *p;
+
+    (void) nthreads;
+    *pool = (CCbigguy_pool *) NULL;
+    p = CC_SAFE_MALLOC (1, CCbigguy_pool);
+    if (!p) return 1;
+    p->nthreads = 1;
+    *pool = p;
+    return 0;
+}
+
+void CCbigguy_pool_free (CCbigguy_pool *pool)
+{
+    CC_IFFREE (pool, CCbigguy_pool);
+}
+
+void CCbigguy_pool_run (CCbigguy_pool *pool, int ntasks,
+        void (*task) (void *arg, int i), void *arg)
+{
+    int i;
+
+    (void) pool;
+    for (i = 0; i < ntasks; i++) task (arg, i);
+}
+
+#endif /* CC_POSIXTHREADS */
+
+int CCbigguy_pool_nthreads (const CCbigguy_pool *pool)
+{
+    return pool ? pool->nthreads : 1;
+}
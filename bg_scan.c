@@ -0,0 +1,317 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  PARALLEL BIGGUY PREFIX SUMS                                             */
+/*                                                                          */
+/*  The running sum is kept as an exact 192-bit number, so adding a term    */
+/*  never overflows; a prefix fits in a CCbigguy iff the top 64 bits are    */
+/*  the sign of the 128 below them.  The array is cut into one block per    */
+/*  thread of the pool (blocks are at least BIGGUY_SCAN_MINBLOCK long).     */
+/*  The first pass sums each block, the block sums are added up in block    */
+/*  order to give each block its starting prefix, and the second pass       */
+/*  rescans each block from its start, writing the prefixes.  A prefix      */
+/*  that does not fit is just not stored; the blocks keep going, and their  */
+/*  overflow flags are combined with the check of the final sum at the      */
+/*  end.  As the arithmetic is exact, out, acc and the return value are     */
+/*  the same as for the serial scan (one block, scanned in a single pass),  */
+/*  for any number of threads.                                              */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_scan_incl_chk (CCbigguy_pool *pool, CCbigguy *acc,         */
+/*      const CCbigguy *y, const int *m, int n, CCbigguy *out)              */
+/*    out[i] = acc + y[0]*m[0] + ... + y[i]*m[i], for i < n, and            */
+/*    acc += y[0]*m[0] + ... + y[n-1]*m[n-1].  If m is NULL, the weights    */
+/*    are all 1.  out may be y.                                             */
+/*                                                                          */
+/*  int CCbigguy_scan_excl_chk (CCbigguy_pool *pool, CCbigguy *acc,         */
+/*      const CCbigguy *y, const int *m, int n, CCbigguy *out)              */
+/*    As CCbigguy_scan_incl_chk, but out[i] stops at y[i-1]*m[i-1] (so      */
+/*    out[0] = acc).                                                        */
+/*                                                                          */
+/*    The two return 1 if some out[i] or the final acc does not fit in a    */
+/*    CCbigguy (leaving those unchanged, and setting the others), and 0     */
+/*    otherwise.                                                            */
+/*                                                                          */
+/*  void CCbigguy_scan_incl (CCbigguy_pool *pool, CCbigguy *acc,            */
+/*      const CCbigguy *y, const int *m, int n, CCbigguy *out)              */
+/*  void CCbigguy_scan_excl (CCbigguy_pool *pool, CCbigguy *acc,            */
+/*      const CCbigguy *y, const int *m, int n, CCbigguy *out)              */
+/*    As above, but on overflow an error message is output and the          */
+/*    routine aborts.                                                       */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+#include "bg_inline.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define BIGGUY_SCAN_MINBLOCK 4096
+#define BIGGUY_SCAN_MAXBLOCKS 64
+#define BIGGUY_SCAN_LINE 64
+
+/* s2:s1:s0 is a 192-bit two's complement number; s1:s0 is the CCbigguy */
+
+typedef struct bigguy_scan_sum {
+    unsigned long long s0;
+    unsigned long long s1;
+    unsigned long long s2;
+    int ovf;
+} bigguy_scan_sum;
+
+typedef union bigguy_scan_part {
+    bigguy_scan_sum s;
+    char line[BIGGUY_SCAN_LINE * ((sizeof (bigguy_scan_sum) +
+                                   BIGGUY_SCAN_LINE - 1) / BIGGUY_SCAN_LINE)];
+} bigguy_scan_part;
+
+typedef struct bigguy_scan_job {
+    const CCbigguy *y;
+    const int *m;
+    CCbigguy *out;
+    int n;
+    int nblocks;
+    int excl;
+    bigguy_scan_part *part;
+} bigguy_scan_job;
+
+static void
+    scan_sum_block (void *arg, int b),
+    scan_out_block (void *arg, int b);
+
+static int
+    scan (CCbigguy_pool *pool, CCbigguy *acc, const CCbigguy *y,
+        const int *m, int n, CCbigguy *out, int excl);
+
+
+static inline void scan_load (bigguy_scan_sum *s, CCbigguy x)
+{
+    s->s0 = ((unsigned long long) x.fhi << 32) | x.flo;
+    s->s1 = ((unsigned long long) x.ihi << 32) | x.ilo;
+    s->s2 = 0 - (s->s1 >> 63);
+}
+
+/* stores s in *x and returns 0 if it fits, returns 1 if not */
+
+static inline int scan_store (const bigguy_scan_sum *s, CCbigguy *x)
+{
+    if (CCbigguy_UNLIKELY (s->s2 != 0 - (s->s1 >> 63))) return 1;
+    x->ihi = (unsigned int) (s->s1 >> 32);
+    x->ilo = (unsigned int) s->s1;
+    x->fhi = (unsigned int) (s->s0 >> 32);
+    x->flo = (unsigned int) s->s0;
+    return 0;
+}
+
+static inline void scan_add3 (bigguy_scan_sum *s, unsigned long long p0,
+        unsigned long long p1, unsigned long long p2)
+{
+    unsigned long long c, t;
+
+    s->s0 += p0;
+    c = (s->s0 < p0);
+    t = s->s1 + c;
+    c = (t < c);
+    s->s1 = t + p1;
+    c += (s->s1 < p1);
+    s->s2 += p2 + c;
+}
+
+/* s += y * m, as in CCbigguy_inline_addmult_ll_chk but without the check */
+
+static inline void scan_addmult (bigguy_scan_sum *s, CCbigguy y, int m)
+{
+    unsigned long long y0, y1, mu, p0, p1, p2, t, neg, mask, c;
+
+    y0 = ((unsigned long long) y.fhi << 32) | y.flo;
+    y1 = ((unsigned long long) y.ihi << 32) | y.ilo;
+    neg = y1 >> 63;
+    mask = 0 - neg;
+    y0 = (y0 ^ mask) + neg;
+    y1 = (y1 ^ mask) + (neg & (y0 == 0));
+    mu = (m < 0) ? 0 - (unsigned long long) m : (unsigned long long) m;
+    neg ^= (unsigned long long) (m < 0);
+
+    p0 = CCbigguy_inline_umul64 (y0, mu, &t);
+    p1 = CCbigguy_inline_umul64 (y1, mu, &p2);
+    p1 += t;
+    p2 += (p1 < t);
+
+    mask = 0 - neg;
+    p0 = (p0 ^ mask) + neg;
+    c = neg & (p0 == 0);
+    p1 = (p1 ^ mask) + c;
+    c &= (p1 == 0);
+    p2 = (p2 ^ mask) + c;
+
+    scan_add3 (s, p0, p1, p2);
+}
+
+static inline void scan_add (bigguy_scan_sum *s, CCbigguy y)
+{
+    unsigned long long y1 = ((unsigned long long) y.ihi << 32) | y.ilo;
+
+    scan_add3 (s, ((unsigned long long) y.fhi << 32) | y.flo, y1,
+               0 - (y1 >> 63));
+}
+
+static void scan_sum_block (void *arg, int b)
+{
+    bigguy_scan_job *job = (bigguy_scan_job *) arg;
+    bigguy_scan_sum s;
+    const CCbigguy *y = job->y;
+    const int *m = job->m;
+    int lo = (int) ((long long) job->n * b / job->nblocks);
+    int hi = (int) ((long long) job->n * (b + 1) / job->nblocks);
+    int i;
+
+    s.s0 = s.s1 = s.s2 = 0;
+    if (m) {
+        for (i = lo; i < hi; i++) scan_addmult (&s, y[i], m[i]);
+    } else {
+        for (i = lo; i < hi; i++) scan_add (&s, y[i]);
+    }
+    s.ovf = 0;
+    job->part[b].s = s;
+}
+
+/* y[i] is read before out[i] is written, so out may be y */
+
+static void scan_out_block (void *arg, int b)
+{
+    bigguy_scan_job *job = (bigguy_scan_job *) arg;
+    bigguy_scan_sum s = job->part[b].s;
+    const CCbigguy *y = job->y;
+    const int *m = job->m;
+    CCbigguy *out = job->out;
+    CCbigguy v;
+    int lo = (int) ((long long) job->n * b / job->nblocks);
+    int hi = (int) ((long long) job->n * (b + 1) / job->nblocks);
+    int i, ovf = 0;
+
+    if (job->excl) {
+        if (m) {
+            for (i = lo; i < hi; i++) {
+                v = y[i];
+                ovf |= scan_store (&s, &out[i]);
+                scan_addmult (&s, v, m[i]);
+            }
+        } else {
+            for (i = lo; i < hi; i++) {
+                v = y[i];
+                ovf |= scan_store (&s, &out[i]);
+                scan_add (&s, v);
+            }
+        }
+    } else {
+        if (m) {
+            for (i = lo; i < hi; i++) {
+                scan_addmult (&s, y[i], m[i]);
+                ovf |= scan_store (&s, &out[i]);
+            }
+        } else {
+            for (i = lo; i < hi; i++) {
+                scan_add (&s, y[i]);
+                ovf |= scan_store (&s, &out[i]);
+            }
+        }
+    }
+    s.ovf = ovf;
+    job->part[b].s = s;
+}
+
+static int scan (CCbigguy_pool *pool, CCbigguy *acc, const CCbigguy *y,
+        const int *m, int n, CCbigguy *out, int excl)
+{
+    char space[(BIGGUY_SCAN_MAXBLOCKS + 1) * sizeof (bigguy_scan_part)];
+    bigguy_scan_job job;
+    bigguy_scan_sum off, t;
+    size_t a;
+    int b, ovf = 0;
+
+    job.y = y;
+    job.m = m;
+    job.out = out;
+    job.n = n;
+    job.excl = excl;
+    job.nblocks = CCbigguy_pool_nthreads (pool);
+    if (job.nblocks > n / BIGGUY_SCAN_MINBLOCK) {
+        job.nblocks = n / BIGGUY_SCAN_MINBLOCK;
+    }
+    if (job.nblocks > BIGGUY_SCAN_MAXBLOCKS) {
+        job.nblocks = BIGGUY_SCAN_MAXBLOCKS;
+    }
+    if (job.nblocks < 1) job.nblocks = 1;
+
+    a = (size_t) space;
+    a = (a + BIGGUY_SCAN_LINE - 1) & ~((size_t) BIGGUY_SCAN_LINE - 1);
+    job.part = (bigguy_scan_part *) a;
+
+    /* first pass: block sums, turned into each block's starting prefix */
+
+    scan_load (&off, *acc);
+    if (job.nblocks > 1) {
+        CCbigguy_pool_run (pool, job.nblocks, scan_sum_block, &job);
+        for (b = 0; b < job.nblocks; b++) {
+            t = job.part[b].s;
+            job.part[b].s = off;
+            scan_add3 (&off, t.s0, t.s1, t.s2);
+        }
+    } else {
+        job.part[0].s = off;
+    }
+
+    /* second pass: the prefixes; a block ends on the next one's start */
+
+    CCbigguy_pool_run (pool, job.nblocks, scan_out_block, &job);
+    for (b = 0; b < job.nblocks; b++) ovf |= job.part[b].s.ovf;
+    ovf |= scan_store (&job.part[job.nblocks - 1].s, acc);
+    return ovf;
+}
+
+int CCbigguy_scan_incl_chk (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *m, int n, CCbigguy *out)
+{
+    return scan (pool, acc, y, m, n, out, 0);
+}
+
+int CCbigguy_scan_excl_chk (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *m, int n, CCbigguy *out)
+{
+    return scan (pool, acc, y, m, n, out, 1);
+}
+
+void CCbigguy_scan_incl (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *m, int n, CCbigguy *out)
+{
+    if (CCbigguy_UNLIKELY (scan (pool, acc, y, m, n, out, 0))) {
+        CCbigguy_overflow ("CCbigguy_scan_incl");
+    }
+}
+
+void CCbigguy_scan_excl (CCbigguy_pool *pool, CCbigguy *acc,
+        const CCbigguy *y, const int *m, int n, CCbigguy *out)
+{
+    if (CCbigguy_UNLIKELY (scan (pool, acc, y, m, n, out, 1))) {
+        CCbigguy_overflow ("CCbigguy_scan_excl");
+    }
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,326 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  SELECTING AND SORTING BIGGUY ARRAYS                                     */
+/*                                                                          */
+/*  Each CCbigguy is compared through its 128-bit order-preserving key      */
+/*  (CCbigguy_KEYHI:CCbigguy_KEYLO in bg_inline.h), two unsigned 64-bit     */
+/*  compares combined without branches.  The sorts are LSD radix sorts on   */
+/*  the key, a byte at a time, skipping the bytes where all keys agree      */
+/*  (the top bytes, for arrays of small values).  Ties always go to the     */
+/*  smaller index.                                                          */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  CCbigguy CCbigguy_array_min (const CCbigguy *x, int n)                  */
+/*  CCbigguy CCbigguy_array_max (const CCbigguy *x, int n)                  */
+/*    The least (greatest) of x[0..n-1]; CCbigguy_MAXBIGGUY                 */
+/*    (CCbigguy_MINBIGGUY) if n is 0.                                       */
+/*                                                                          */
+/*  int CCbigguy_array_argmin (const CCbigguy *x, int n)                    */
+/*  int CCbigguy_array_argmax (const CCbigguy *x, int n)                    */
+/*    The first index of the least (greatest) x[i], or -1 if n is 0.        */
+/*                                                                          */
+/*  int CCbigguy_array_count_below (const CCbigguy *x, int n,               */
+/*      CCbigguy bound)                                                     */
+/*    The number of x[i] < bound.                                           */
+/*                                                                          */
+/*  int CCbigguy_array_topk (const CCbigguy *x, int n, int k, int *ind)     */
+/*    Puts the indices of the k least x[i] in ind, in increasing order of   */
+/*    x[i], and returns how many there are (the smaller of k and n).  ind   */
+/*    must have room for k.  (For the k greatest, negate the values.)       */
+/*                                                                          */
+/*  int CCbigguy_radixsort (CCbigguy *x, int n)                             */
+/*    Sorts x[0..n-1] into increasing order.  Returns 0 on success, 1 if    */
+/*    it runs out of memory (leaving x unchanged).                          */
+/*                                                                          */
+/*  int CCbigguy_perm_radixsort (int *perm, const CCbigguy *x, int n)       */
+/*    Reorders perm[0..n-1] so that x[perm[0]] <= x[perm[1]] <= ...,       */
+/*    keeping the order of perm among equal values.  Returns 0 on           */
+/*    success, 1 if it runs out of memory (leaving perm unchanged).         */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+#include "bg_inline.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define BIGGUY_SORT_SMALL 48
+
+typedef struct bigguy_sort_rec {
+    unsigned long long hi;
+    unsigned long long lo;
+    int idx;
+} bigguy_sort_rec;
+
+/* (ah:al) < (bh:bl), as 0 or 1 */
+
+#define KEY_LESS(ah,al,bh,bl) (((ah) < (bh)) |                        \
+                               (((ah) == (bh)) & ((al) < (bl))))
+
+static void
+    sort_small (bigguy_sort_rec *r, int n),
+    topk_sift (const CCbigguy *x, int *heap, int k, int i);
+
+static int
+    array_arg (const CCbigguy *x, int n, int max),
+    sort_recs (bigguy_sort_rec *r, int n),
+    topk_greater (const CCbigguy *x, int a, int b);
+
+
+/* the first index of the least x[i], or of the greatest if max */
+
+static int array_arg (const CCbigguy *x, int n, int max)
+{
+    unsigned long long bh, bl, h, l, flip;
+    int i, best, better;
+
+    if (n <= 0) return -1;
+
+    /* for the maximum, complement the keys and look for the least */
+    flip = max ? ~0ULL : 0ULL;
+    bh = CCbigguy_KEYHI(x[0]) ^ flip;
+    bl = CCbigguy_KEYLO(x[0]) ^ flip;
+    best = 0;
+    for (i = 1; i < n; i++) {
+        h = CCbigguy_KEYHI(x[i]) ^ flip;
+        l = CCbigguy_KEYLO(x[i]) ^ flip;
+        better = KEY_LESS (h, l, bh, bl);
+        bh = better ? h : bh;
+        bl = better ? l : bl;
+        best = better ? i : best;
+    }
+    return best;
+}
+
+int CCbigguy_array_argmin (const CCbigguy *x, int n)
+{
+    return array_arg (x, n, 0);
+}
+
+int CCbigguy_array_argmax (const CCbigguy *x, int n)
+{
+    return array_arg (x, n, 1);
+}
+
+CCbigguy CCbigguy_array_min (const CCbigguy *x, int n)
+{
+    return (n > 0) ? x[array_arg (x, n, 0)] : CCbigguy_MAXBIGGUY;
+}
+
+CCbigguy CCbigguy_array_max (const CCbigguy *x, int n)
+{
+    return (n > 0) ? x[array_arg (x, n, 1)] : CCbigguy_MINBIGGUY;
+}
+
+int CCbigguy_array_count_below (const CCbigguy *x, int n, CCbigguy bound)
+{
+    unsigned long long bh = CCbigguy_KEYHI(bound);
+    unsigned long long bl = CCbigguy_KEYLO(bound);
+    unsigned long long h, l;
+    int i, count = 0;
+
+    for (i = 0; i < n; i++) {
+        h = CCbigguy_KEYHI(x[i]);
+        l = CCbigguy_KEYLO(x[i]);
+        count += (int) KEY_LESS (h, l, bh, bl);
+    }
+    return count;
+}
+
+/* x[a] after x[b], with ties broken by index */
+
+static int topk_greater (const CCbigguy *x, int a, int b)
+{
+    unsigned long long ah = CCbigguy_KEYHI(x[a]), al = CCbigguy_KEYLO(x[a]);
+    unsigned long long bh = CCbigguy_KEYHI(x[b]), bl = CCbigguy_KEYLO(x[b]);
+
+    if (ah != bh) return ah > bh;
+    if (al != bl) return al > bl;
+    return a > b;
+}
+
+/* heap[0..k-1] is a heap with the last of the k at the top */
+
+static void topk_sift (const CCbigguy *x, int *heap, int k, int i)
+{
+    int c, t = heap[i];
+
+    while ((c = 2 * i + 1) < k) {
+        if (c + 1 < k && topk_greater (x, heap[c+1], heap[c])) c++;
+        if (!topk_greater (x, heap[c], t)) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = t;
+}
+
+int CCbigguy_array_topk (const CCbigguy *x, int n, int k, int *ind)
+{
+    unsigned long long th, tl, h, l;
+    int i, t;
+
+    if (k > n) k = n;
+    if (k <= 0) return 0;
+
+    for (i = 0; i < k; i++) ind[i] = i;
+    for (i = k / 2 - 1; i >= 0; i--) topk_sift (x, ind, k, i);
+
+    /* later indices lose ties, so x[i] gets in only if below the top */
+    th = CCbigguy_KEYHI(x[ind[0]]);
+    tl = CCbigguy_KEYLO(x[ind[0]]);
+    for (i = k; i < n; i++) {
+        h = CCbigguy_KEYHI(x[i]);
+        l = CCbigguy_KEYLO(x[i]);
+        if (KEY_LESS (h, l, th, tl)) {
+            ind[0] = i;
+            topk_sift (x, ind, k, 0);
+            th = CCbigguy_KEYHI(x[ind[0]]);
+            tl = CCbigguy_KEYLO(x[ind[0]]);
+        }
+    }
+
+    /* take the top off to the end, leaving ind in increasing order */
+    for (i = k - 1; i > 0; i--) {
+        t = ind[0];
+        ind[0] = ind[i];
+        ind[i] = t;
+        topk_sift (x, ind, i, 0);
+    }
+    return k;
+}
+
+/* stable insertion sort, for short arrays */
+
+static void sort_small (bigguy_sort_rec *r, int n)
+{
+    bigguy_sort_rec t;
+    int i, j;
+
+    for (i = 1; i < n; i++) {
+        t = r[i];
+        for (j = i; j > 0 && KEY_LESS (t.hi, t.lo, r[j-1].hi, r[j-1].lo);
+             j--) {
+            r[j] = r[j-1];
+        }
+        r[j] = t;
+    }
+}
+
+/* stable LSD radix sort of r on hi:lo; returns 1 if out of memory */
+
+static int sort_recs (bigguy_sort_rec *r, int n)
+{
+    int count[16][256];
+    bigguy_sort_rec *buf, *from, *to, *t;
+    unsigned long long v;
+    int d, i, b, s, sum;
+
+    if (n < BIGGUY_SORT_SMALL) {
+        sort_small (r, n);
+        return 0;
+    }
+    buf = CC_SAFE_MALLOC (n, bigguy_sort_rec);
+    if (!buf) return 1;
+
+    memset (count, 0, sizeof (count));
+    for (i = 0; i < n; i++) {
+        for (d = 0; d < 8; d++) {
+            count[d][(r[i].lo >> (8 * d)) & 0xff]++;
+            count[d+8][(r[i].hi >> (8 * d)) & 0xff]++;
+        }
+    }
+
+    from = r;
+    to = buf;
+    for (d = 0; d < 16; d++) {
+        v = (d < 8) ? r[0].lo : r[0].hi;
+        s = 8 * (d & 7);
+        if (count[d][(v >> s) & 0xff] == n) continue;
+
+        for (b = 0, sum = 0; b < 256; b++) {
+            i = count[d][b];
+            count[d][b] = sum;
+            sum += i;
+        }
+        for (i = 0; i < n; i++) {
+            v = (d < 8) ? from[i].lo : from[i].hi;
+            to[count[d][(v >> s) & 0xff]++] = from[i];
+        }
+        t = from;
+        from = to;
+        to = t;
+    }
+    if (from != r) memcpy (r, from, n * sizeof (bigguy_sort_rec));
+
+    CC_FREE (buf, bigguy_sort_rec);
+    return 0;
+}
+
+int CCbigguy_radixsort (CCbigguy *x, int n)
+{
+    bigguy_sort_rec *r;
+    int i;
+
+    if (n <= 1) return 0;
+    r = CC_SAFE_MALLOC (n, bigguy_sort_rec);
+    if (!r) return 1;
+    for (i = 0; i < n; i++) {
+        r[i].hi = CCbigguy_KEYHI(x[i]);
+        r[i].lo = CCbigguy_KEYLO(x[i]);
+        r[i].idx = i;
+    }
+    if (sort_recs (r, n)) {
+        CC_FREE (r, bigguy_sort_rec);
+        return 1;
+    }
+    for (i = 0; i < n; i++) {
+        x[i].ihi = (unsigned int) (r[i].hi >> 32) ^ 0x80000000u;
+        x[i].ilo = (unsigned int) r[i].hi;
+        x[i].fhi = (unsigned int) (r[i].lo >> 32);
+        x[i].flo = (unsigned int) r[i].lo;
+    }
+    CC_FREE (r, bigguy_sort_rec);
+    return 0;
+}
+
+int CCbigguy_perm_radixsort (int *perm, const CCbigguy *x, int n)
+{
+    bigguy_sort_rec *r;
+    int i;
+
+    if (n <= 1) return 0;
+    r = CC_SAFE_MALLOC (n, bigguy_sort_rec);
+    if (!r) return 1;
+    for (i = 0; i < n; i++) {
+        r[i].hi = CCbigguy_KEYHI(x[perm[i]]);
+        r[i].lo = CCbigguy_KEYLO(x[perm[i]]);
+        r[i].idx = perm[i];
+    }
+    if (sort_recs (r, n)) {
+        CC_FREE (r, bigguy_sort_rec);
+        return 1;
+    }
+    for (i = 0; i < n; i++) perm[i] = r[i].idx;
+    CC_FREE (r, bigguy_sort_rec);
+    return 0;
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
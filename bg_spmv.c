@@ -0,0 +1,186 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  SPARSE MATRIX TIMES BIGGUY VECTOR                                       */
+/*                                                                          */
+/*  The matrix A is an nrows-row int matrix in compressed sparse row form:  */
+/*  the nonzeros of row i are val[k] in column colind[k], for k from        */
+/*  rowbeg[i] to rowbeg[i+1]-1.  Each row is summed exactly in a            */
+/*  CCbigguy_wide (CCbigguy_wide_dot_sparse, which prefetches the           */
+/*  gathered pi[j]), so only the row sum is checked for overflow.  The      */
+/*  rows are split into tasks of at least BIGGUY_SPMV_MINROWS rows and run  */
+/*  on the pool; no two tasks write to the same output, so the results do  */
+/*  not depend on the number of threads.                                    */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_spmv_chk (CCbigguy_pool *pool, int nrows,                  */
+/*      const int *rowbeg, const int *colind, const int *val,               */
+/*      const CCbigguy *pi, CCbigguy *out)                                  */
+/*    out[i] = sum of A[i][j] * pi[j].  Returns 1 if some row sum           */
+/*    overflows (leaving that out[i] unchanged), and 0 otherwise.           */
+/*                                                                          */
+/*  void CCbigguy_spmv (CCbigguy_pool *pool, int nrows, const int *rowbeg,  */
+/*      const int *colind, const int *val, const CCbigguy *pi,              */
+/*      CCbigguy *out)                                                      */
+/*    As above, but if a row sum overflows, an error message is output     */
+/*    and the routine aborts.                                               */
+/*                                                                          */
+/*  int CCbigguy_spmv_viol (CCbigguy_pool *pool, int nrows,                 */
+/*      const int *rowbeg, const int *colind, const int *val,               */
+/*      const CCbigguy *pi, const CCbigguy *bound, int *viol)               */
+/*    Finds the rows with sum of A[i][j] * pi[j] > bound[i], puts their     */
+/*    indices in viol in increasing order, and returns how many there       */
+/*    are.  viol must have room for nrows.  The row sums are compared in    */
+/*    the wide form, so the answer is exact even for row sums that do not  */
+/*    fit in a CCbigguy.  (To test for sums below the bound, negate val     */
+/*    and bound.)                                                           */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#define BIGGUY_SPMV_MINROWS 512
+#define BIGGUY_SPMV_MAXTASKS 256
+
+typedef struct bigguy_spmv_job {
+    int nrows;
+    int ntasks;
+    const int *rowbeg;
+    const int *colind;
+    const int *val;
+    const CCbigguy *pi;
+    const CCbigguy *bound;
+    CCbigguy *out;
+    int *viol;
+    int count[BIGGUY_SPMV_MAXTASKS];
+} bigguy_spmv_job;
+
+static void
+    spmv_setup (bigguy_spmv_job *job, int nrows, const int *rowbeg,
+        const int *colind, const int *val, const CCbigguy *pi),
+    spmv_task (void *arg, int t),
+    spmv_viol_task (void *arg, int t);
+
+
+static void spmv_setup (bigguy_spmv_job *job, int nrows, const int *rowbeg,
+        const int *colind, const int *val, const CCbigguy *pi)
+{
+    job->nrows = nrows;
+    job->rowbeg = rowbeg;
+    job->colind = colind;
+    job->val = val;
+    job->pi = pi;
+    job->ntasks = nrows / BIGGUY_SPMV_MINROWS;
+    if (job->ntasks > BIGGUY_SPMV_MAXTASKS) {
+        job->ntasks = BIGGUY_SPMV_MAXTASKS;
+    }
+    if (job->ntasks < 1) job->ntasks = 1;
+}
+
+/* row sums; count[t] is set if a row of task t overflows */
+
+static void spmv_task (void *arg, int t)
+{
+    bigguy_spmv_job *job = (bigguy_spmv_job *) arg;
+    int lo = (int) ((long long) job->nrows * t / job->ntasks);
+    int hi = (int) ((long long) job->nrows * (t + 1) / job->ntasks);
+    const int *rowbeg = job->rowbeg;
+    CCbigguy_wide w;
+    int i, ovf = 0;
+
+    for (i = lo; i < hi; i++) {
+        CCbigguy_wide_init (&w, CCbigguy_ZERO);
+        CCbigguy_wide_dot_sparse (&w, job->pi, job->colind + rowbeg[i],
+                                  job->val + rowbeg[i],
+                                  rowbeg[i+1] - rowbeg[i]);
+        ovf |= CCbigguy_wide_narrow (&w, &job->out[i]);
+    }
+    job->count[t] = ovf;
+}
+
+/* the violated rows of task t go to viol[lo..], and their number to  */
+/* count[t]                                                           */
+
+static void spmv_viol_task (void *arg, int t)
+{
+    bigguy_spmv_job *job = (bigguy_spmv_job *) arg;
+    int lo = (int) ((long long) job->nrows * t / job->ntasks);
+    int hi = (int) ((long long) job->nrows * (t + 1) / job->ntasks);
+    const int *rowbeg = job->rowbeg;
+    int *viol = job->viol + lo;
+    CCbigguy_wide w;
+    int i;
+
+    for (i = lo; i < hi; i++) {
+        CCbigguy_wide_init (&w, CCbigguy_ZERO);
+        CCbigguy_wide_dot_sparse (&w, job->pi, job->colind + rowbeg[i],
+                                  job->val + rowbeg[i],
+                                  rowbeg[i+1] - rowbeg[i]);
+        CCbigguy_wide_addmult (&w, &job->bound[i], -1);
+        if (CCbigguy_wide_sign (&w) > 0) *viol++ = i;
+    }
+    job->count[t] = (int) (viol - (job->viol + lo));
+}
+
+int CCbigguy_spmv_chk (CCbigguy_pool *pool, int nrows, const int *rowbeg,
+        const int *colind, const int *val, const CCbigguy *pi, CCbigguy *out)
+{
+    bigguy_spmv_job job;
+    int t, ovf = 0;
+
+    spmv_setup (&job, nrows, rowbeg, colind, val, pi);
+    job.out = out;
+    CCbigguy_pool_run (pool, job.ntasks, spmv_task, &job);
+    for (t = 0; t < job.ntasks; t++) ovf |= job.count[t];
+    return ovf;
+}
+
+void CCbigguy_spmv (CCbigguy_pool *pool, int nrows, const int *rowbeg,
+        const int *colind, const int *val, const CCbigguy *pi, CCbigguy *out)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_spmv_chk (pool, nrows, rowbeg, colind,
+                                              val, pi, out))) {
+        CCbigguy_overflow ("CCbigguy_spmv");
+    }
+}
+
+int CCbigguy_spmv_viol (CCbigguy_pool *pool, int nrows, const int *rowbeg,
+        const int *colind, const int *val, const CCbigguy *pi,
+        const CCbigguy *bound, int *viol)
+{
+    bigguy_spmv_job job;
+    int t, k, lo, nviol = 0;
+
+    spmv_setup (&job, nrows, rowbeg, colind, val, pi);
+    job.bound = bound;
+    job.viol = viol;
+    CCbigguy_pool_run (pool, job.ntasks, spmv_viol_task, &job);
+
+    /* move each task's rows down behind those of the tasks before it */
+    for (t = 0; t < job.ntasks; t++) {
+        lo = (int) ((long long) nrows * t / job.ntasks);
+        for (k = 0; k < job.count[t]; k++) viol[nviol++] = viol[lo + k];
+    }
+    return nviol;
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,334 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  BIGGUY OPERATION STATISTICS                                             */
+/*                                                                          */
+/*  If the library is built with CC_BIGGUY_STATS (in BGFLAGS), the          */
+/*  exported add, sub, addmult, cmp, ceil, dot and conversion routines      */
+/*  count what they do: the calls of each, how many limbs each carry or     */
+/*  borrow ran through, the multipliers by size, and the results by         */
+/*  magnitude and by the number of fraction bits in use.  The largest       */
+/*  magnitude seen says how much headroom is left below                     */
+/*  CCbigguy_MAXBIGGUY.  Each thread counts into its own block, so the      */
+/*  counting takes no locks; the blocks are added up when the statistics    */
+/*  are read.  The inline arithmetic of CC_BIGGUY_INLINE and the kernels    */
+/*  called inside the library (bg_wide.c, bg_vec.c, ...) are not counted,   */
+/*  and CC_BIGGUY_STATS turns CC_BIGGUY_INLINE off.                         */
+/*                                                                          */
+/*  Without CC_BIGGUY_STATS the hooks are empty macros, so the routines     */
+/*  are exactly as fast as before, and the functions below report zeros.   */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  void CCbigguy_stats_get (CCbigguy_stats *s)                             */
+/*    Sets s to the totals over all threads.                                */
+/*                                                                          */
+/*  void CCbigguy_stats_reset (void)                                        */
+/*    Zeros the counts of every thread.  The counts of threads using        */
+/*    bigguys at the same time may be partly kept.                          */
+/*                                                                          */
+/*  void CCbigguy_stats_dump (FILE *out)                                    */
+/*    Prints the totals to out.                                             */
+/*                                                                          */
+/*  void CCbigguy_stats_arith (int op, const CCbigguy *x, CCbigguy y,       */
+/*      long long m, const CCbigguy *r)                                     */
+/*  void CCbigguy_stats_calls (int op, int n)                               */
+/*  void CCbigguy_stats_result (int op, const CCbigguy *r, int n)           */
+/*    The hooks, called through the CCbigguy_STATS_* macros of              */
+/*    bg_inline.h: r = x + y*m (NULL if that overflowed), n calls of op,    */
+/*    and the results r[0..n-1] of n calls of op (r is NULL if one of them  */
+/*    overflowed).                                                          */
+/*                                                                          */
+/****************************************************************************/
+
+/* the hooks are called from the CCbigguy128 routines, so CCbigguy is */
+/* CCbigguy128 here whatever CC_BIGGUY_LONGLONG says                  */
+#undef CC_BIGGUY_LONGLONG
+#undef CC_BIGGUY_LONG
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#ifdef CC_BIGGUY_STATS
+
+#ifdef CC_POSIXTHREADS
+#include <pthread.h>
+#endif
+
+#ifdef __GNUC__
+#define STATS_TLS __thread
+#else
+#define STATS_TLS
+#endif
+
+typedef struct stats_block {
+    CCbigguy_stats s;
+    struct stats_block *next;
+} stats_block;
+
+/* every thread's block, kept after the thread exits so that its counts */
+/* stay in the totals                                                    */
+
+static stats_block *stats_all = (stats_block *) NULL;
+static STATS_TLS stats_block *stats_mine = (stats_block *) NULL;
+
+#ifdef CC_POSIXTHREADS
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+#define STATS_LOCK()   pthread_mutex_lock (&stats_lock)
+#define STATS_UNLOCK() pthread_mutex_unlock (&stats_lock)
+#else
+#define STATS_LOCK()
+#define STATS_UNLOCK()
+#endif
+
+static const char *stats_opname[CCbigguy_STAT_NOPS] = {
+    "add", "sub", "addmult", "cmp", "ceil", "dot", "dtobigguy", "bigguytod"
+};
+
+static CCbigguy_stats
+    *stats_get_mine (void);
+
+static void
+    stats_sum (CCbigguy_stats *s, const CCbigguy_stats *t),
+    stats_record_result (CCbigguy_stats *s, const CCbigguy *r);
+
+static int
+    stats_bitlen (unsigned long long v);
+
+
+static int stats_bitlen (unsigned long long v)
+{
+    int b = 0;
+
+    while (v) {
+        b++;
+        v >>= 1;
+    }
+    return b;
+}
+
+static CCbigguy_stats *stats_get_mine (void)
+{
+    stats_block *b = stats_mine;
+
+    if (b) return &b->s;
+    b = CC_SAFE_MALLOC (1, stats_block);
+    if (!b) return (CCbigguy_stats *) NULL;
+    memset (&b->s, 0, sizeof (CCbigguy_stats));
+    STATS_LOCK ();
+    b->next = stats_all;
+    stats_all = b;
+    STATS_UNLOCK ();
+    stats_mine = b;
+    return &b->s;
+}
+
+static void stats_sum (CCbigguy_stats *s, const CCbigguy_stats *t)
+{
+    int i, j;
+
+    for (i = 0; i < CCbigguy_STAT_NOPS; i++) {
+        s->calls[i] += t->calls[i];
+        for (j = 0; j <= CCbigguy_STAT_OVERFLOW; j++) {
+            s->carry[i][j] += t->carry[i][j];
+        }
+    }
+    for (i = 0; i <= 64; i++) s->mult[i] += t->mult[i];
+    s->mhi += t->mhi;
+    for (i = 0; i <= 128; i++) s->mag[i] += t->mag[i];
+    for (i = 0; i <= 64; i++) s->frac[i] += t->frac[i];
+}
+
+static void stats_record_result (CCbigguy_stats *s, const CCbigguy *r)
+{
+    unsigned long long hi = ((unsigned long long) r->ihi << 32) | r->ilo;
+    unsigned long long lo = ((unsigned long long) r->fhi << 32) | r->flo;
+    unsigned long long f = lo;
+    int b = 0;
+
+    /* -x has the same trailing zeros as x */
+    if (f) {
+        for (b = 64; !(f & 1); f >>= 1) b--;
+    }
+    s->frac[b]++;
+
+    if (hi >> 63) {
+        lo = 0 - lo;
+        hi = ~hi + (lo == 0);
+    }
+    s->mag[hi ? 64 + stats_bitlen (hi) : stats_bitlen (lo)]++;
+}
+
+void CCbigguy_stats_arith (int op, const CCbigguy *x, CCbigguy y,
+        long long m, const CCbigguy *r)
+{
+    CCbigguy_stats *s = stats_get_mine ();
+    unsigned long long yhi, ylo, mag, t, carry;
+    unsigned int yl[4], a[4], xl[4], rl[4];
+    int neg, k, depth;
+
+    if (!s) return;
+    s->calls[op]++;
+    neg = (m < 0);
+    mag = neg ? 0 - (unsigned long long) m : (unsigned long long) m;
+    if (op == CCbigguy_STAT_ADDMULT) {
+        s->mult[stats_bitlen (mag)]++;
+        if (m < -2147483647LL - 1 || m > BIT_32_SMAX) s->mhi++;
+    }
+    if (!r) {
+        s->carry[op][CCbigguy_STAT_OVERFLOW]++;
+        return;
+    }
+
+    /* a = |y*m| mod 2^128, in limbs from the low end; r = x + a if */
+    /* y*m >= 0, and r = x - a otherwise                             */
+    yhi = ((unsigned long long) y.ihi << 32) | y.ilo;
+    ylo = ((unsigned long long) y.fhi << 32) | y.flo;
+    if (yhi >> 63) {
+        neg = !neg;
+        ylo = 0 - ylo;
+        yhi = ~yhi + (ylo == 0);
+    }
+    yl[0] = (unsigned int) ylo;
+    yl[1] = (unsigned int) (ylo >> 32);
+    yl[2] = (unsigned int) yhi;
+    yl[3] = (unsigned int) (yhi >> 32);
+    for (k = 0, carry = 0; k < 4; k++) {
+        t = (unsigned long long) yl[k] * (mag & 0xffffffffULL) + carry;
+        a[k] = (unsigned int) t;
+        carry = t >> 32;
+    }
+    for (k = 1, carry = 0; k < 4; k++) {
+        t = (unsigned long long) yl[k-1] * (mag >> 32) + a[k] + carry;
+        a[k] = (unsigned int) t;
+        carry = t >> 32;
+    }
+
+    xl[0] = x->flo; xl[1] = x->fhi; xl[2] = x->ilo; xl[3] = x->ihi;
+    rl[0] = r->flo; rl[1] = r->fhi; rl[2] = r->ilo; rl[3] = r->ihi;
+
+    /* a carry (or borrow) reached limb k if r differs there from x +- a */
+    for (k = 1, depth = 0; k < 4; k++) {
+        if (rl[k] != (neg ? xl[k] - a[k] : xl[k] + a[k])) depth = k;
+    }
+    s->carry[op][depth]++;
+    stats_record_result (s, r);
+}
+
+void CCbigguy_stats_calls (int op, int n)
+{
+    CCbigguy_stats *s = stats_get_mine ();
+
+    if (s) s->calls[op] += (unsigned long long) n;
+}
+
+void CCbigguy_stats_result (int op, const CCbigguy *r, int n)
+{
+    CCbigguy_stats *s = stats_get_mine ();
+    int i;
+
+    if (!s) return;
+    s->calls[op] += (unsigned long long) n;
+    if (!r) s->carry[op][CCbigguy_STAT_OVERFLOW]++;
+    else    for (i = 0; i < n; i++) stats_record_result (s, &r[i]);
+}
+
+void CCbigguy_stats_get (CCbigguy_stats *s)
+{
+    stats_block *b;
+
+    memset (s, 0, sizeof (CCbigguy_stats));
+    STATS_LOCK ();
+    for (b = stats_all; b; b = b->next) stats_sum (s, &b->s);
+    STATS_UNLOCK ();
+}
+
+void CCbigguy_stats_reset (void)
+{
+    stats_block *b;
+
+    STATS_LOCK ();
+    for (b = stats_all; b; b = b->next) {
+        memset (&b->s, 0, sizeof (CCbigguy_stats));
+    }
+    STATS_UNLOCK ();
+}
+
+void CCbigguy_stats_dump (FILE *out)
+{
+    CCbigguy_stats s;
+    int i, top = 0;
+
+    CCbigguy_stats_get (&s);
+
+    fprintf (out, "bigguy stats\n");
+    fprintf (out, "  %-10s %14s %12s %12s %12s %12s %10s\n", "op", "calls",
+             "carry0", "carry1", "carry2", "carry3", "overflow");
+    for (i = 0; i < CCbigguy_STAT_NOPS; i++) {
+        if (!s.calls[i]) continue;
+        fprintf (out, "  %-10s %14llu %12llu %12llu %12llu %12llu %10llu\n",
+                 stats_opname[i], s.calls[i], s.carry[i][0], s.carry[i][1],
+                 s.carry[i][2], s.carry[i][3],
+                 s.carry[i][CCbigguy_STAT_OVERFLOW]);
+    }
+
+    fprintf (out, "addmult multipliers by bits of |m|, %llu beyond 32 bits\n",
+             s.mhi);
+    for (i = 0; i <= 64; i++) {
+        if (s.mult[i]) fprintf (out, "  %2d bits %14llu\n", i, s.mult[i]);
+    }
+
+    fprintf (out, "results by magnitude\n");
+    for (i = 0; i <= 128; i++) {
+        if (!s.mag[i]) continue;
+        if (i == 0) fprintf (out, "  x = 0         %14llu\n", s.mag[i]);
+        else fprintf (out, "  |x| < 2^%-4d %14llu\n", i - 64, s.mag[i]);
+        top = i;
+    }
+    if (top) {
+        fprintf (out, "  headroom: %d bits below CCbigguy_MAXBIGGUY\n",
+                 127 - top);
+    }
+
+    fprintf (out, "results by fraction bits used\n");
+    for (i = 0; i <= 64; i++) {
+        if (s.frac[i]) fprintf (out, "  %2d bits %14llu\n", i, s.frac[i]);
+    }
+}
+
+#else /* CC_BIGGUY_STATS */
+
+void CCbigguy_stats_get (CCbigguy_stats *s)
+{
+    memset (s, 0, sizeof (CCbigguy_stats));
+}
+
+void CCbigguy_stats_reset (void)
+{
+}
+
+void CCbigguy_stats_dump (FILE *out)
+{
+    fprintf (out, "bigguy stats: not built with CC_BIGGUY_STATS\n");
+}
+
+#endif /* CC_BIGGUY_STATS */
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,664 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  BIGGUY VECTORS                                                          */
+/*                                                                          */
+/*  A CCbigguy_vec stores n bigguys as four arrays, one per limb, each      */
+/*  aligned to 64 bytes.  The element-wise kernels below run 16 (AVX-512)   */
+/*  or 8 (AVX2) elements at a time when the compiler targets those          */
+/*  instruction sets (for example with -mavx2 or -mavx512f in BGFLAGS),     */
+/*  and fall back to portable scalar loops otherwise.  Every kernel gives   */
+/*  the same bits as the corresponding bigguy.c function (where that        */
+/*  function would abort, the kernel sets the overflow flag instead).       */
+/*                                                                          */
+/*  Instead of aborting, the kernels that can overflow return 1 if any      */
+/*  element overflowed (and 0 otherwise); the values of the elements that   */
+/*  overflowed are then undefined.  The vectors passed to a kernel must     */
+/*  have the same length.                                                   */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  int CCbigguy_vec_init (CCbigguy_vec *v, int n)                          */
+/*    Allocates a vector of n zeros.  Returns 0 on success, 1 if out of     */
+/*    memory.                                                               */
+/*                                                                          */
+/*  void CCbigguy_vec_free (CCbigguy_vec *v)                                */
+/*                                                                          */
+/*  CCbigguy CCbigguy_vec_get (const CCbigguy_vec *v, int i)                */
+/*  void CCbigguy_vec_set (CCbigguy_vec *v, int i, CCbigguy x)              */
+/*                                                                          */
+/*  int CCbigguy_vec_add (CCbigguy_vec *x, const CCbigguy_vec *y)           */
+/*  int CCbigguy_vec_sub (CCbigguy_vec *x, const CCbigguy_vec *y)           */
+/*    x[i] += y[i] and x[i] -= y[i].                                        */
+/*                                                                          */
+/*  int CCbigguy_vec_addmult (CCbigguy_vec *x, const CCbigguy_vec *y,       */
+/*      const int *m)                                                       */
+/*    x[i] += y[i] * m[i].                                                  */
+/*                                                                          */
+/*  int CCbigguy_vec_ceil (CCbigguy_vec *x)                                 */
+/*    x[i] = ceil (x[i]).                                                   */
+/*                                                                          */
+/*  void CCbigguy_vec_cmp (const CCbigguy_vec *x, CCbigguy y, int *cmp)     */
+/*    cmp[i] = CCbigguy_cmp (x[i], y).                                      */
+/*                                                                          */
+/*  void CCbigguy_vec_bigguytod (const CCbigguy_vec *x, double *d)          */
+/*    d[i] = CCbigguy_bigguytod (x[i]).  This one is not vectorized, since  */
+/*    the rounding depends on the position of each leading bit.             */
+/*                                                                          */
+/****************************************************************************/
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+#ifndef CC_BIGGUY_BUILTIN
+
+#if defined(__AVX512F__)
+#define BGVEC_AVX512
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define BGVEC_AVX2
+#include <immintrin.h>
+#endif
+
+#define BGVEC_ALIGN 64
+#define BGVEC_PAD   16          /* elements per 64 bytes of one limb */
+
+static int
+    add_range (CCbigguy_vec *x, const CCbigguy_vec *y, int i, int n),
+    sub_range (CCbigguy_vec *x, const CCbigguy_vec *y, int i, int n),
+    addmult_range (CCbigguy_vec *x, const CCbigguy_vec *y, const int *m,
+        int i, int n),
+    ceil_range (CCbigguy_vec *x, int i, int n);
+
+static void
+    cmp_range (const CCbigguy_vec *x, CCbigguy y, int *cmp, int i, int n),
+    bigguytod_range (const CCbigguy_vec *x, double *d, int i, int n);
+
+
+int CCbigguy_vec_init (CCbigguy_vec *v, int n)
+{
+    int space = (n + BGVEC_PAD - 1) / BGVEC_PAD * BGVEC_PAD;
+    size_t a;
+
+    v->n = 0;
+    v->ihi = v->ilo = v->fhi = v->flo = (unsigned int *) NULL;
+    v->mem = CC_SAFE_MALLOC (4 * (size_t) space * sizeof (unsigned int)
+                             + BGVEC_ALIGN, char);
+    if (!v->mem) return 1;
+    memset (v->mem, 0, 4 * (size_t) space * sizeof (unsigned int)
+                       + BGVEC_ALIGN);
+
+    a = (size_t) v->mem;
+    a = (a + BGVEC_ALIGN - 1) & ~((size_t) BGVEC_ALIGN - 1);
+    v->ihi = (unsigned int *) a;
+    v->ilo = v->ihi + space;
+    v->fhi = v->ilo + space;
+    v->flo = v->fhi + space;
+    v->n = n;
+    return 0;
+}
+
+void CCbigguy_vec_free (CCbigguy_vec *v)
+{
+    CC_IFFREE (v->mem, char);
+    v->ihi = v->ilo = v->fhi = v->flo = (unsigned int *) NULL;
+    v->n = 0;
+}
+
+CCbigguy CCbigguy_vec_get (const CCbigguy_vec *v, int i)
+{
+    CCbigguy x;
+
+    x.ihi = v->ihi[i];
+    x.ilo = v->ilo[i];
+    x.fhi = v->fhi[i];
+    x.flo = v->flo[i];
+    return x;
+}
+
+void CCbigguy_vec_set (CCbigguy_vec *v, int i, CCbigguy x)
+{
+    v->ihi[i] = x.ihi;
+    v->ilo[i] = x.ilo;
+    v->fhi[i] = x.fhi;
+    v->flo[i] = x.flo;
+}
+
+/*  Portable kernels, also used for the tails of the SIMD loops.  */
+
+static int add_range (CCbigguy_vec *x, const CCbigguy_vec *y, int i, int n)
+{
+    unsigned long long c;
+    unsigned int sx, ovf = 0;
+
+    for (; i < n; i++) {
+        sx = x->ihi[i];
+        c = (unsigned long long) x->flo[i] + y->flo[i];
+        x->flo[i] = (unsigned int) c;
+        c = (c >> 32) + x->fhi[i] + y->fhi[i];
+        x->fhi[i] = (unsigned int) c;
+        c = (c >> 32) + x->ilo[i] + y->ilo[i];
+        x->ilo[i] = (unsigned int) c;
+        c = (c >> 32) + x->ihi[i] + y->ihi[i];
+        x->ihi[i] = (unsigned int) c;
+        ovf |= (sx ^ x->ihi[i]) & (y->ihi[i] ^ x->ihi[i]);
+    }
+    return ovf >> 31;
+}
+
+static int sub_range (CCbigguy_vec *x, const CCbigguy_vec *y, int i, int n)
+{
+    unsigned long long c;
+    unsigned int sx, ovf = 0;
+
+    for (; i < n; i++) {
+        sx = x->ihi[i];
+        c = (unsigned long long) x->flo[i] + (unsigned int) ~y->flo[i] + 1;
+        x->flo[i] = (unsigned int) c;
+        c = (c >> 32) + x->fhi[i] + (unsigned int) ~y->fhi[i];
+        x->fhi[i] = (unsigned int) c;
+        c = (c >> 32) + x->ilo[i] + (unsigned int) ~y->ilo[i];
+        x->ilo[i] = (unsigned int) c;
+        c = (c >> 32) + x->ihi[i] + (unsigned int) ~y->ihi[i];
+        x->ihi[i] = (unsigned int) c;
+        ovf |= (sx ^ y->ihi[i]) & (sx ^ x->ihi[i]);
+    }
+    return ovf >> 31;
+}
+
+/*  addmult works on signed 64-bit digit sums: with y = u3:u2:u1:u0 and   */
+/*  p_k = u_k * m, digit k of x + y*m is x_k + lo(p_k) + hi(p_{k-1}) plus  */
+/*  the carry, and the digit above ihi is -sign(x) - sign(y)*m + hi(p_3)   */
+/*  plus the carry.  The sum fits iff that digit is the sign extension    */
+/*  of the new ihi.                                                       */
+
+static int addmult_range (CCbigguy_vec *x, const CCbigguy_vec *y,
+        const int *mm, int i, int n)
+{
+    long long m, p, d;
+    unsigned int r;
+    int ovf = 0;
+
+    for (; i < n; i++) {
+        m = mm[i];
+        p = (long long) y->flo[i] * m;
+        d = (long long) x->flo[i] + (p & 0xffffffff);
+        x->flo[i] = (unsigned int) d;
+        d = (d >> 32) + (p >> 32);
+        p = (long long) y->fhi[i] * m;
+        d += (long long) x->fhi[i] + (p & 0xffffffff);
+        x->fhi[i] = (unsigned int) d;
+        d = (d >> 32) + (p >> 32);
+        p = (long long) y->ilo[i] * m;
+        d += (long long) x->ilo[i] + (p & 0xffffffff);
+        x->ilo[i] = (unsigned int) d;
+        d = (d >> 32) + (p >> 32);
+        p = (long long) y->ihi[i] * m;
+        d += (long long) x->ihi[i] + (p & 0xffffffff);
+        d -= (long long) (x->ihi[i] >> 31) << 32;
+        r = (unsigned int) d;
+        x->ihi[i] = r;
+        d = (d >> 32) + (p >> 32) - (long long) (y->ihi[i] >> 31) * m;
+        ovf |= (d != -(long long) (r >> 31));
+    }
+    return ovf;
+}
+
+static int ceil_range (CCbigguy_vec *x, int i, int n)
+{
+    unsigned int ovf = 0;
+
+    for (; i < n; i++) {
+        if (x->fhi[i] | x->flo[i]) {
+            x->fhi[i] = 0;
+            x->flo[i] = 0;
+            x->ilo[i]++;
+            if (x->ilo[i] == 0) {
+                ovf |= (x->ihi[i] == (unsigned int) BIT_32_SMAX);
+                x->ihi[i]++;
+            }
+        }
+    }
+    return (int) ovf;
+}
+
+static void cmp_range (const CCbigguy_vec *x, CCbigguy y, int *cmp, int i,
+        int n)
+{
+    int hi;
+
+    for (; i < n; i++) {
+        hi = ((int) x->ihi[i] > (int) y.ihi) - ((int) x->ihi[i] < (int) y.ihi);
+        if (hi) { cmp[i] = hi; continue; }
+        if (x->ilo[i] != y.ilo) { cmp[i] = (x->ilo[i] > y.ilo) ? 1 : -1; continue; }
+        if (x->fhi[i] != y.fhi) { cmp[i] = (x->fhi[i] > y.fhi) ? 1 : -1; continue; }
+        cmp[i] = (x->flo[i] > y.flo) - (x->flo[i] < y.flo);
+    }
+}
+
+static void bigguytod_range (const CCbigguy_vec *x, double *d, int i, int n)
+{
+    for (; i < n; i++) {
+        d[i] = CCbigguy_bigguytod (CCbigguy_vec_get (x, i));
+    }
+}
+
+#ifdef BGVEC_AVX2
+
+#define LTU(a,b) _mm256_cmpgt_epi32 (_mm256_xor_si256 ((b), sgn),           \
+                                     _mm256_xor_si256 ((a), sgn))
+
+/* a + b + c (c is a -1/0 mask), setting c to the carry out */
+
+#define ADC8(r,a,b,c) {                                                     \
+    __m256i s_ = _mm256_add_epi32 ((a), (b));                               \
+    __m256i c_ = LTU (s_, (a));                                             \
+    (r) = _mm256_sub_epi32 (s_, (c));                                       \
+    (c) = _mm256_or_si256 (c_, _mm256_and_si256 ((c),                       \
+                           _mm256_cmpeq_epi32 (s_, ones)));                 \
+}
+
+#define LD8(a)   _mm256_load_si256 ((const __m256i *) (a))
+#define ST8(a,v) _mm256_store_si256 ((__m256i *) (a), (v))
+
+static int addsub_avx2 (CCbigguy_vec *x, const CCbigguy_vec *y, int sub,
+        int *pi)
+{
+    const __m256i sgn = _mm256_set1_epi32 ((int) 0x80000000);
+    const __m256i ones = _mm256_set1_epi32 (-1);
+    const __m256i inv = sub ? ones : _mm256_setzero_si256 ();
+    __m256i ovf = _mm256_setzero_si256 ();
+    __m256i c, a, b, r;
+    int i, n = x->n;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        c = inv;
+        a = LD8 (x->flo + i); b = _mm256_xor_si256 (LD8 (y->flo + i), inv);
+        ADC8 (r, a, b, c); ST8 (x->flo + i, r);
+        a = LD8 (x->fhi + i); b = _mm256_xor_si256 (LD8 (y->fhi + i), inv);
+        ADC8 (r, a, b, c); ST8 (x->fhi + i, r);
+        a = LD8 (x->ilo + i); b = _mm256_xor_si256 (LD8 (y->ilo + i), inv);
+        ADC8 (r, a, b, c); ST8 (x->ilo + i, r);
+        a = LD8 (x->ihi + i); b = _mm256_xor_si256 (LD8 (y->ihi + i), inv);
+        ADC8 (r, a, b, c); ST8 (x->ihi + i, r);
+        /* the operands agree in sign and the result does not */
+        ovf = _mm256_or_si256 (ovf, _mm256_and_si256 (_mm256_xor_si256 (a, r),
+                                                      _mm256_xor_si256 (b, r)));
+    }
+    *pi = i;
+    return _mm256_movemask_ps (_mm256_castsi256_ps (ovf)) != 0;
+}
+
+/* arithmetic shift right by 32 of 64-bit lanes */
+
+static __m256i srai32_epi64 (__m256i v)
+{
+    return _mm256_blend_epi32 (_mm256_srli_epi64 (v, 32),
+                               _mm256_srai_epi32 (v, 31), 0xaa);
+}
+
+#define LDU4(a) _mm256_cvtepu32_epi64 (_mm_load_si128 ((const __m128i *) (a)))
+
+static void st4 (unsigned int *a, __m256i v)
+{
+    const __m256i idx = _mm256_setr_epi32 (0, 2, 4, 6, 0, 2, 4, 6);
+
+    _mm_store_si128 ((__m128i *) a,
+        _mm256_castsi256_si128 (_mm256_permutevar8x32_epi32 (v, idx)));
+}
+
+#define ADDMULT_DIGIT(xl,yl) {                                              \
+    u = LDU4 (y->yl + i);                                                   \
+    neg = _mm256_cmpgt_epi64 (u, smax);                                     \
+    p = _mm256_add_epi64 (_mm256_mul_epi32 (u, m),                          \
+                          _mm256_and_si256 (neg, mhi));                     \
+    xv = LDU4 (x->xl + i);                                                  \
+    d = _mm256_add_epi64 (d, _mm256_add_epi64 (xv,                          \
+                          _mm256_and_si256 (p, lo)));                       \
+}
+
+static int addmult_avx2 (CCbigguy_vec *x, const CCbigguy_vec *y,
+        const int *mm, int *pi)
+{
+    const __m256i lo = _mm256_set1_epi64x (0xffffffffLL);
+    const __m256i smax = _mm256_set1_epi64x (0x7fffffffLL);
+    __m256i ovf = _mm256_setzero_si256 ();
+    __m256i m, mhi, u, neg, p, xv, d, r;
+    int i, n = x->n;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        m = _mm256_cvtepi32_epi64 (_mm_loadu_si128 ((const __m128i *) (mm + i)));
+        mhi = _mm256_slli_epi64 (m, 32);
+        d = _mm256_setzero_si256 ();
+
+        ADDMULT_DIGIT (flo, flo);
+        st4 (x->flo + i, d);
+        d = _mm256_add_epi64 (srai32_epi64 (d), srai32_epi64 (p));
+        ADDMULT_DIGIT (fhi, fhi);
+        st4 (x->fhi + i, d);
+        d = _mm256_add_epi64 (srai32_epi64 (d), srai32_epi64 (p));
+        ADDMULT_DIGIT (ilo, ilo);
+        st4 (x->ilo + i, d);
+        d = _mm256_add_epi64 (srai32_epi64 (d), srai32_epi64 (p));
+        ADDMULT_DIGIT (ihi, ihi);
+        st4 (x->ihi + i, d);
+        r = _mm256_and_si256 (d, lo);
+        d = _mm256_add_epi64 (srai32_epi64 (d), srai32_epi64 (p));
+        d = _mm256_sub_epi64 (d, _mm256_srli_epi64 (xv, 31));
+        d = _mm256_sub_epi64 (d, _mm256_and_si256 (neg, m));
+        d = _mm256_add_epi64 (d, _mm256_srli_epi64 (r, 31));
+        ovf = _mm256_or_si256 (ovf, d);
+    }
+    *pi = i;
+    return !_mm256_testz_si256 (ovf, ovf);
+}
+
+static int ceil_avx2 (CCbigguy_vec *x, int *pi)
+{
+    const __m256i zero = _mm256_setzero_si256 ();
+    const __m256i ones = _mm256_set1_epi32 (-1);
+    const __m256i smax = _mm256_set1_epi32 (0x7fffffff);
+    __m256i ovf = zero;
+    __m256i nz, c, hi, il;
+    int i, n = x->n;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        nz = _mm256_cmpeq_epi32 (_mm256_or_si256 (LD8 (x->fhi + i),
+                                                  LD8 (x->flo + i)), zero);
+        nz = _mm256_xor_si256 (nz, ones);
+        il = LD8 (x->ilo + i);
+        hi = LD8 (x->ihi + i);
+        c = _mm256_and_si256 (nz, _mm256_cmpeq_epi32 (il, ones));
+        ovf = _mm256_or_si256 (ovf, _mm256_and_si256 (c,
+                                    _mm256_cmpeq_epi32 (hi, smax)));
+        ST8 (x->ilo + i, _mm256_sub_epi32 (il, nz));
+        ST8 (x->ihi + i, _mm256_sub_epi32 (hi, c));
+        ST8 (x->fhi + i, _mm256_andnot_si256 (nz, LD8 (x->fhi + i)));
+        ST8 (x->flo + i, _mm256_andnot_si256 (nz, LD8 (x->flo + i)));
+    }
+    *pi = i;
+    return !_mm256_testz_si256 (ovf, ovf);
+}
+
+static void cmp_avx2 (const CCbigguy_vec *x, CCbigguy y, int *cmp, int *pi)
+{
+    const __m256i sgn = _mm256_set1_epi32 ((int) 0x80000000);
+    const __m256i yihi = _mm256_set1_epi32 ((int) y.ihi);
+    const __m256i yilo = _mm256_set1_epi32 ((int) (y.ilo ^ 0x80000000));
+    const __m256i yfhi = _mm256_set1_epi32 ((int) (y.fhi ^ 0x80000000));
+    const __m256i yflo = _mm256_set1_epi32 ((int) (y.flo ^ 0x80000000));
+    __m256i a, gt, lt, eq;
+    int i, n = x->n;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        a = _mm256_xor_si256 (LD8 (x->flo + i), sgn);
+        gt = _mm256_cmpgt_epi32 (a, yflo);
+        lt = _mm256_cmpgt_epi32 (yflo, a);
+        a = _mm256_xor_si256 (LD8 (x->fhi + i), sgn);
+        eq = _mm256_cmpeq_epi32 (a, yfhi);
+        gt = _mm256_or_si256 (_mm256_cmpgt_epi32 (a, yfhi),
+                              _mm256_and_si256 (eq, gt));
+        lt = _mm256_or_si256 (_mm256_cmpgt_epi32 (yfhi, a),
+                              _mm256_and_si256 (eq, lt));
+        a = _mm256_xor_si256 (LD8 (x->ilo + i), sgn);
+        eq = _mm256_cmpeq_epi32 (a, yilo);
+        gt = _mm256_or_si256 (_mm256_cmpgt_epi32 (a, yilo),
+                              _mm256_and_si256 (eq, gt));
+        lt = _mm256_or_si256 (_mm256_cmpgt_epi32 (yilo, a),
+                              _mm256_and_si256 (eq, lt));
+        a = LD8 (x->ihi + i);
+        eq = _mm256_cmpeq_epi32 (a, yihi);
+        gt = _mm256_or_si256 (_mm256_cmpgt_epi32 (a, yihi),
+                              _mm256_and_si256 (eq, gt));
+        lt = _mm256_or_si256 (_mm256_cmpgt_epi32 (yihi, a),
+                              _mm256_and_si256 (eq, lt));
+        _mm256_storeu_si256 ((__m256i *) (cmp + i), _mm256_sub_epi32 (lt, gt));
+    }
+    *pi = i;
+}
+
+#endif /* BGVEC_AVX2 */
+
+#ifdef BGVEC_AVX512
+
+#define LD16(a)   _mm512_load_si512 ((const void *) (a))
+#define ST16(a,v) _mm512_store_si512 ((void *) (a), (v))
+
+/* a + b + c (c is a carry mask), setting c to the carry out */
+
+#define ADC16(r,a,b,c) {                                                    \
+    __m512i s_ = _mm512_add_epi32 ((a), (b));                               \
+    __mmask16 c_ = _mm512_cmplt_epu32_mask (s_, (a));                       \
+    (r) = _mm512_mask_add_epi32 (s_, (c), s_, one);                         \
+    (c) = c_ | ((c) & _mm512_cmpeq_epi32_mask (s_, ones));                  \
+}
+
+static int addsub_avx512 (CCbigguy_vec *x, const CCbigguy_vec *y, int sub,
+        int *pi)
+{
+    const __m512i one = _mm512_set1_epi32 (1);
+    const __m512i ones = _mm512_set1_epi32 (-1);
+    const __m512i inv = sub ? ones : _mm512_setzero_si512 ();
+    const __mmask16 cin = sub ? 0xffff : 0;
+    __m512i ovf = _mm512_setzero_si512 ();
+    __m512i a, b, r;
+    __mmask16 c;
+    int i, n = x->n;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        c = cin;
+        a = LD16 (x->flo + i); b = _mm512_xor_si512 (LD16 (y->flo + i), inv);
+        ADC16 (r, a, b, c); ST16 (x->flo + i, r);
+        a = LD16 (x->fhi + i); b = _mm512_xor_si512 (LD16 (y->fhi + i), inv);
+        ADC16 (r, a, b, c); ST16 (x->fhi + i, r);
+        a = LD16 (x->ilo + i); b = _mm512_xor_si512 (LD16 (y->ilo + i), inv);
+        ADC16 (r, a, b, c); ST16 (x->ilo + i, r);
+        a = LD16 (x->ihi + i); b = _mm512_xor_si512 (LD16 (y->ihi + i), inv);
+        ADC16 (r, a, b, c); ST16 (x->ihi + i, r);
+        ovf = _mm512_or_si512 (ovf, _mm512_and_si512 (_mm512_xor_si512 (a, r),
+                                                      _mm512_xor_si512 (b, r)));
+    }
+    *pi = i;
+    return _mm512_test_epi32_mask (ovf, _mm512_set1_epi32 ((int) 0x80000000))
+           != 0;
+}
+
+#define LDU8(a) _mm512_cvtepu32_epi64 (_mm256_load_si256 ((const __m256i *) (a)))
+#define STU8(a,v) _mm256_store_si256 ((__m256i *) (a), _mm512_cvtepi64_epi32 (v))
+
+#define ADDMULT_DIGIT16(xl,yl) {                                            \
+    u = LDU8 (y->yl + i);                                                   \
+    neg = _mm512_test_epi64_mask (u, bit31);                                \
+    p = _mm512_mul_epi32 (u, m);                                            \
+    p = _mm512_mask_add_epi64 (p, neg, p, mhi);                             \
+    xv = LDU8 (x->xl + i);                                                  \
+    d = _mm512_add_epi64 (d, _mm512_add_epi64 (xv,                          \
+                          _mm512_and_si512 (p, lo)));                       \
+}
+
+static int addmult_avx512 (CCbigguy_vec *x, const CCbigguy_vec *y,
+        const int *mm, int *pi)
+{
+    const __m512i lo = _mm512_set1_epi64 (0xffffffffLL);
+    const __m512i bit31 = _mm512_set1_epi64 (0x80000000LL);
+    __mmask8 ovf = 0, neg;
+    __m512i m, mhi, u, p, xv, d, r;
+    int i, n = x->n;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        m = _mm512_cvtepi32_epi64 (_mm256_loadu_si256 ((const __m256i *) (mm + i)));
+        mhi = _mm512_slli_epi64 (m, 32);
+        d = _mm512_setzero_si512 ();
+
+        ADDMULT_DIGIT16 (flo, flo);
+        STU8 (x->flo + i, d);
+        d = _mm512_add_epi64 (_mm512_srai_epi64 (d, 32),
+                              _mm512_srai_epi64 (p, 32));
+        ADDMULT_DIGIT16 (fhi, fhi);
+        STU8 (x->fhi + i, d);
+        d = _mm512_add_epi64 (_mm512_srai_epi64 (d, 32),
+                              _mm512_srai_epi64 (p, 32));
+        ADDMULT_DIGIT16 (ilo, ilo);
+        STU8 (x->ilo + i, d);
+        d = _mm512_add_epi64 (_mm512_srai_epi64 (d, 32),
+                              _mm512_srai_epi64 (p, 32));
+        ADDMULT_DIGIT16 (ihi, ihi);
+        STU8 (x->ihi + i, d);
+        r = _mm512_and_si512 (d, lo);
+        d = _mm512_add_epi64 (_mm512_srai_epi64 (d, 32),
+                              _mm512_srai_epi64 (p, 32));
+        d = _mm512_sub_epi64 (d, _mm512_srli_epi64 (xv, 31));
+        d = _mm512_mask_sub_epi64 (d, neg, d, m);
+        ovf |= _mm512_cmpneq_epi64_mask (d,
+                   _mm512_sub_epi64 (_mm512_setzero_si512 (),
+                                     _mm512_srli_epi64 (r, 31)));
+    }
+    *pi = i;
+    return ovf != 0;
+}
+
+static int ceil_avx512 (CCbigguy_vec *x, int *pi)
+{
+    const __m512i zero = _mm512_setzero_si512 ();
+    const __m512i one = _mm512_set1_epi32 (1);
+    const __m512i ones = _mm512_set1_epi32 (-1);
+    const __m512i smax = _mm512_set1_epi32 (0x7fffffff);
+    __mmask16 ovf = 0, nz, c;
+    __m512i hi, il;
+    int i, n = x->n;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        nz = _mm512_test_epi32_mask (_mm512_or_si512 (LD16 (x->fhi + i),
+                                                      LD16 (x->flo + i)), ones);
+        il = LD16 (x->ilo + i);
+        hi = LD16 (x->ihi + i);
+        c = nz & _mm512_cmpeq_epi32_mask (il, ones);
+        ovf |= c & _mm512_cmpeq_epi32_mask (hi, smax);
+        ST16 (x->ilo + i, _mm512_mask_add_epi32 (il, nz, il, one));
+        ST16 (x->ihi + i, _mm512_mask_add_epi32 (hi, c, hi, one));
+        ST16 (x->fhi + i, _mm512_mask_mov_epi32 (LD16 (x->fhi + i), nz, zero));
+        ST16 (x->flo + i, _mm512_mask_mov_epi32 (LD16 (x->flo + i), nz, zero));
+    }
+    *pi = i;
+    return ovf != 0;
+}
+
+static void cmp_avx512 (const CCbigguy_vec *x, CCbigguy y, int *cmp, int *pi)
+{
+    const __m512i yihi = _mm512_set1_epi32 ((int) y.ihi);
+    const __m512i yilo = _mm512_set1_epi32 ((int) y.ilo);
+    const __m512i yfhi = _mm512_set1_epi32 ((int) y.fhi);
+    const __m512i yflo = _mm512_set1_epi32 ((int) y.flo);
+    const __m512i one = _mm512_set1_epi32 (1);
+    const __m512i ones = _mm512_set1_epi32 (-1);
+    __mmask16 gt, lt, eq;
+    __m512i a, r;
+    int i, n = x->n;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        a = LD16 (x->flo + i);
+        gt = _mm512_cmpgt_epu32_mask (a, yflo);
+        lt = _mm512_cmplt_epu32_mask (a, yflo);
+        a = LD16 (x->fhi + i);
+        eq = _mm512_cmpeq_epi32_mask (a, yfhi);
+        gt = _mm512_cmpgt_epu32_mask (a, yfhi) | (eq & gt);
+        lt = _mm512_cmplt_epu32_mask (a, yfhi) | (eq & lt);
+        a = LD16 (x->ilo + i);
+        eq = _mm512_cmpeq_epi32_mask (a, yilo);
+        gt = _mm512_cmpgt_epu32_mask (a, yilo) | (eq & gt);
+        lt = _mm512_cmplt_epu32_mask (a, yilo) | (eq & lt);
+        a = LD16 (x->ihi + i);
+        eq = _mm512_cmpeq_epi32_mask (a, yihi);
+        gt = _mm512_cmpgt_epi32_mask (a, yihi) | (eq & gt);
+        lt = _mm512_cmplt_epi32_mask (a, yihi) | (eq & lt);
+        r = _mm512_maskz_mov_epi32 (gt, one);
+        r = _mm512_mask_mov_epi32 (r, lt, ones);
+        _mm512_storeu_si512 ((void *) (cmp + i), r);
+    }
+    *pi = i;
+}
+
+#endif /* BGVEC_AVX512 */
+
+int CCbigguy_vec_add (CCbigguy_vec *x, const CCbigguy_vec *y)
+{
+    int i = 0, ovf = 0;
+
+#if defined(BGVEC_AVX512)
+    ovf = addsub_avx512 (x, y, 0, &i);
+#elif defined(BGVEC_AVX2)
+    ovf = addsub_avx2 (x, y, 0, &i);
+#endif
+    return add_range (x, y, i, x->n) | ovf;
+}
+
+int CCbigguy_vec_sub (CCbigguy_vec *x, const CCbigguy_vec *y)
+{
+    int i = 0, ovf = 0;
+
+#if defined(BGVEC_AVX512)
+    ovf = addsub_avx512 (x, y, 1, &i);
+#elif defined(BGVEC_AVX2)
+    ovf = addsub_avx2 (x, y, 1, &i);
+#endif
+    return sub_range (x, y, i, x->n) | ovf;
+}
+
+int CCbigguy_vec_addmult (CCbigguy_vec *x, const CCbigguy_vec *y,
+        const int *m)
+{
+    int i = 0, ovf = 0;
+
+#if defined(BGVEC_AVX512)
+    ovf = addmult_avx512 (x, y, m, &i);
+#elif defined(BGVEC_AVX2)
+    ovf = addmult_avx2 (x, y, m, &i);
+#endif
+    return addmult_range (x, y, m, i, x->n) | ovf;
+}
+
+int CCbigguy_vec_ceil (CCbigguy_vec *x)
+{
+    int i = 0, ovf = 0;
+
+#if defined(BGVEC_AVX512)
+    ovf = ceil_avx512 (x, &i);
+#elif defined(BGVEC_AVX2)
+    ovf = ceil_avx2 (x, &i);
+#endif
+    return ceil_range (x, i, x->n) | ovf;
+}
+
+void CCbigguy_vec_cmp (const CCbigguy_vec *x, CCbigguy y, int *cmp)
+{
+    int i = 0;
+
+#if defined(BGVEC_AVX512)
+    cmp_avx512 (x, y, cmp, &i);
+#elif defined(BGVEC_AVX2)
+    cmp_avx2 (x, y, cmp, &i);
+#endif
+    cmp_range (x, y, cmp, i, x->n);
+}
+
+void CCbigguy_vec_bigguytod (const CCbigguy_vec *x, double *d)
+{
+    bigguytod_range (x, d, 0, x->n);
+}
+
+#endif /* CC_BIGGUY_BUILTIN */
@@ -0,0 +1,314 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  WIDE BIGGUY ACCUMULATORS AND DOT PRODUCTS                               */
+/*                                                                          */
+/*  A CCbigguy_wide holds a sum of bigguy*int terms in six signed 64-bit    */
+/*  lanes, lane k carrying weight 2^(32k) (lane 2 is the units digit of     */
+/*  a CCbigguy).  Each term adds less than 2^33 in magnitude to a lane,     */
+/*  so carries are only propagated every BIGGUY_WIDE_MAXPENDING terms and   */
+/*  when the sum is narrowed back to a CCbigguy.  The normalized value      */
+/*  is a 192-bit two's complement number, so no intermediate sum of fewer   */
+/*  than 2^31 terms can overflow; overflow is tested once, on narrowing.    */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  void CCbigguy_dot (CCbigguy *acc, const CCbigguy *y, const int *m,      */
+/*      int n)                                                              */
+/*    acc += y[0]*m[0] + ... + y[n-1]*m[n-1].  If the final sum overflows,  */
+/*    an error message is output and the routine aborts; intermediate      */
+/*    sums may go out of range.  If CC_BIGGUY_BUILTIN is defined, there    */
+/*    is no overflow checking.                                              */
+/*                                                                          */
+/*  void CCbigguy64_dot (CCbigguy64 *acc, const CCbigguy64 *y,              */
+/*      const int *m, int n)                                                */
+/*  void CCbigguy64_dot_sparse (CCbigguy64 *acc, const CCbigguy64 *y,       */
+/*      const int *ind, const int *m, int n)                                */
+/*    The CCbigguy64 forms, with no overflow checking.  This file is        */
+/*    always built with CCbigguy = CCbigguy128, so both are exported.       */
+/*                                                                          */
+/*  void CCbigguy_dot_sparse (CCbigguy *acc, const CCbigguy *y,             */
+/*      const int *ind, const int *m, int n)                                */
+/*    acc += y[ind[0]]*m[0] + ... + y[ind[n-1]]*m[n-1], as CCbigguy_dot.    */
+/*                                                                          */
+/*  int CCbigguy_dot_chk (CCbigguy *acc, const CCbigguy *y, const int *m,   */
+/*      int n)                                                              */
+/*  int CCbigguy_dot_sparse_chk (CCbigguy *acc, const CCbigguy *y,          */
+/*      const int *ind, const int *m, int n)                                */
+/*    As above, but return 1 (leaving acc unchanged) instead of aborting    */
+/*    if the sum overflows, and 0 otherwise.  These two are in bg_cpu.c,    */
+/*    which may replace the wide sum by one with 64-bit limbs.              */
+/*                                                                          */
+/*  void CCbigguy_wide_init (CCbigguy_wide *w, CCbigguy x)                  */
+/*    Sets w to x.                                                          */
+/*                                                                          */
+/*  void CCbigguy_wide_addmult (CCbigguy_wide *w, const CCbigguy *y, int m) */
+/*    w += y*m.  Cannot overflow.                                           */
+/*                                                                          */
+/*  void CCbigguy_wide_dot (CCbigguy_wide *w, const CCbigguy *y,            */
+/*      const int *m, int n)                                                */
+/*  void CCbigguy_wide_dot_sparse (CCbigguy_wide *w, const CCbigguy *y,     */
+/*      const int *ind, const int *m, int n)                                */
+/*    As CCbigguy_dot and CCbigguy_dot_sparse, accumulating into w.  The    */
+/*    sparse form prefetches y[ind[k+BIGGUY_WIDE_PREFETCH]] ahead of use.   */
+/*                                                                          */
+/*  void CCbigguy_wide_sum (CCbigguy_wide *w, const CCbigguy *y, int n)     */
+/*    w += y[0] + ... + y[n-1].                                             */
+/*                                                                          */
+/*  void CCbigguy_wide_merge (CCbigguy_wide *w, const CCbigguy_wide *v)     */
+/*    w += v.                                                               */
+/*                                                                          */
+/*  int CCbigguy_wide_sign (CCbigguy_wide *w)                               */
+/*    Returns -1, 0 or 1 as w is negative, zero or positive.  This is       */
+/*    exact whether or not w fits in a CCbigguy.                            */
+/*                                                                          */
+/*  int CCbigguy_wide_narrow (CCbigguy_wide *w, CCbigguy *x)                */
+/*    Sets x to the value of w and returns 0, or returns 1 (leaving x       */
+/*    unchanged) if the value does not fit in a CCbigguy.                   */
+/*                                                                          */
+/****************************************************************************/
+
+/* CCbigguy is CCbigguy128 here whatever CC_BIGGUY_LONGLONG says */
+#undef CC_BIGGUY_LONGLONG
+#undef CC_BIGGUY_LONG
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+void CCbigguy64_dot (CCbigguy64 *acc, const CCbigguy64 *y, const int *m,
+        int n)
+{
+    CCbigguy64 s = *acc;
+    int i;
+
+    for (i = 0; i < n; i++) s += y[i] * m[i];
+    *acc = s;
+}
+
+void CCbigguy64_dot_sparse (CCbigguy64 *acc, const CCbigguy64 *y,
+        const int *ind, const int *m, int n)
+{
+    CCbigguy64 s = *acc;
+    int i;
+
+    for (i = 0; i < n; i++) s += y[ind[i]] * m[i];
+    *acc = s;
+}
+
+#define BIGGUY_WIDE_MAXPENDING (1 << 28)
+#define BIGGUY_WIDE_PREFETCH 16
+
+#ifdef __GNUC__
+#define BIGGUY_WIDE_PREFETCH_Y(p) __builtin_prefetch ((p), 0, 1)
+#else
+#define BIGGUY_WIDE_PREFETCH_Y(p)
+#endif
+
+/* l[0..5] += y*m, without carry propagation */
+
+#define BIGGUY_WIDE_TERM(l,y,m) {                                       \
+    long long p_;                                                       \
+    p_ = (long long) (y).flo * (m);                                     \
+    (l)[0] += p_ & 0xffffffff;                                          \
+    (l)[1] += p_ >> 32;                                                 \
+    p_ = (long long) (y).fhi * (m);                                     \
+    (l)[1] += p_ & 0xffffffff;                                          \
+    (l)[2] += p_ >> 32;                                                 \
+    p_ = (long long) (y).ilo * (m);                                     \
+    (l)[2] += p_ & 0xffffffff;                                          \
+    (l)[3] += p_ >> 32;                                                 \
+    p_ = (long long) (y).ihi * (m);                                     \
+    (l)[3] += p_ & 0xffffffff;                                          \
+    (l)[4] += p_ >> 32;                                                 \
+    (l)[4] -= (long long) ((y).ihi >> 31) * (m);                        \
+}
+
+static void
+    wide_normalize (long long *l);
+
+
+static void wide_normalize (long long *l)
+{
+    int k;
+
+    for (k = 0; k < 5; k++) {
+        l[k+1] += l[k] >> 32;
+        l[k] &= 0xffffffff;
+    }
+}
+
+void CCbigguy_wide_init (CCbigguy_wide *w, CCbigguy x)
+{
+    w->lane[0] = x.flo;
+    w->lane[1] = x.fhi;
+    w->lane[2] = x.ilo;
+    w->lane[3] = x.ihi;
+    w->lane[4] = -(long long) (x.ihi >> 31);
+    w->lane[5] = w->lane[4];
+    w->lane[4] &= 0xffffffff;
+    w->pending = 0;
+}
+
+void CCbigguy_wide_addmult (CCbigguy_wide *w, const CCbigguy *y, int m)
+{
+    if (w->pending >= BIGGUY_WIDE_MAXPENDING) {
+        wide_normalize (w->lane);
+        w->pending = 0;
+    }
+    BIGGUY_WIDE_TERM (w->lane, *y, m);
+    w->pending++;
+}
+
+void CCbigguy_wide_dot (CCbigguy_wide *w, const CCbigguy *y, const int *m,
+        int n)
+{
+    long long l[6];
+    int i, k, stop, chunk;
+
+    for (k = 0; k < 6; k++) l[k] = w->lane[k];
+
+    for (i = 0; i < n; i = stop) {
+        if (w->pending >= BIGGUY_WIDE_MAXPENDING) {
+            wide_normalize (l);
+            w->pending = 0;
+        }
+        chunk = BIGGUY_WIDE_MAXPENDING - w->pending;
+        stop = (n - i > chunk) ? i + chunk : n;
+        w->pending += stop - i;
+        for (k = i; k < stop; k++) {
+            BIGGUY_WIDE_TERM (l, y[k], m[k]);
+        }
+    }
+
+    for (k = 0; k < 6; k++) w->lane[k] = l[k];
+}
+
+void CCbigguy_wide_dot_sparse (CCbigguy_wide *w, const CCbigguy *y,
+        const int *ind, const int *m, int n)
+{
+    long long l[6];
+    int i, k, stop, chunk;
+
+    for (k = 0; k < 6; k++) l[k] = w->lane[k];
+
+    for (i = 0; i < n; i = stop) {
+        if (w->pending >= BIGGUY_WIDE_MAXPENDING) {
+            wide_normalize (l);
+            w->pending = 0;
+        }
+        chunk = BIGGUY_WIDE_MAXPENDING - w->pending;
+        stop = (n - i > chunk) ? i + chunk : n;
+        w->pending += stop - i;
+        for (k = i; k + BIGGUY_WIDE_PREFETCH < stop; k++) {
+            BIGGUY_WIDE_PREFETCH_Y (&y[ind[k + BIGGUY_WIDE_PREFETCH]]);
+            BIGGUY_WIDE_TERM (l, y[ind[k]], m[k]);
+        }
+        for (; k < stop; k++) {
+            BIGGUY_WIDE_TERM (l, y[ind[k]], m[k]);
+        }
+    }
+
+    for (k = 0; k < 6; k++) w->lane[k] = l[k];
+}
+
+void CCbigguy_wide_sum (CCbigguy_wide *w, const CCbigguy *y, int n)
+{
+    long long l[6];
+    int i, k, stop, chunk;
+
+    for (k = 0; k < 6; k++) l[k] = w->lane[k];
+
+    for (i = 0; i < n; i = stop) {
+        if (w->pending >= BIGGUY_WIDE_MAXPENDING) {
+            wide_normalize (l);
+            w->pending = 0;
+        }
+        chunk = BIGGUY_WIDE_MAXPENDING - w->pending;
+        stop = (n - i > chunk) ? i + chunk : n;
+        w->pending += stop - i;
+        for (k = i; k < stop; k++) {
+            l[0] += y[k].flo;
+            l[1] += y[k].fhi;
+            l[2] += y[k].ilo;
+            l[3] += y[k].ihi;
+            l[4] -= y[k].ihi >> 31;
+        }
+    }
+
+    for (k = 0; k < 6; k++) w->lane[k] = l[k];
+}
+
+void CCbigguy_wide_merge (CCbigguy_wide *w, const CCbigguy_wide *v)
+{
+    long long l[6];
+    int k;
+
+    for (k = 0; k < 6; k++) l[k] = v->lane[k];
+    wide_normalize (l);
+    wide_normalize (w->lane);
+    for (k = 0; k < 6; k++) w->lane[k] += l[k];
+    w->pending = 1;
+}
+
+int CCbigguy_wide_sign (CCbigguy_wide *w)
+{
+    long long *l = w->lane;
+
+    wide_normalize (l);
+    w->pending = 0;
+
+    if (l[5] < 0) return -1;
+    return (l[5] | l[4] | l[3] | l[2] | l[1] | l[0]) != 0;
+}
+
+int CCbigguy_wide_narrow (CCbigguy_wide *w, CCbigguy *x)
+{
+    long long *l = w->lane;
+
+    wide_normalize (l);
+    w->pending = 0;
+
+    if (l[5] == 0) {
+        if (l[4] != 0 || l[3] >= 2147483648LL) return 1;
+    } else if (l[5] == -1) {
+        if (l[4] != 0xffffffffLL || l[3] < 2147483648LL) return 1;
+    } else {
+        return 1;
+    }
+
+    x->ihi = (unsigned int) l[3];
+    x->ilo = (unsigned int) l[2];
+    x->fhi = (unsigned int) l[1];
+    x->flo = (unsigned int) l[0];
+    return 0;
+}
+
+void CCbigguy_dot (CCbigguy *acc, const CCbigguy *y, const int *m, int n)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_dot_chk (acc, y, m, n))) {
+        CCbigguy_overflow ("CCbigguy_dot");
+    }
+}
+
+void CCbigguy_dot_sparse (CCbigguy *acc, const CCbigguy *y, const int *ind,
+        const int *m, int n)
+{
+    if (CCbigguy_UNLIKELY (CCbigguy_dot_sparse_chk (acc, y, ind, m, n))) {
+        CCbigguy_overflow ("CCbigguy_dot_sparse");
+    }
+}
@@ -0,0 +1,141 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  CONVERTING BETWEEN CCbigguy64 AND CCbigguy128                           */
+/*                                                                          */
+/*  A CCbigguy64 counts units of 2^-32 and a CCbigguy128 units of 2^-64,    */
+/*  so every CCbigguy64 widens exactly.  Narrowing drops 32 fraction bits,  */
+/*  rounded as round says (one of the CCbigguy_ROUND_* modes of bg_mul.c),  */
+/*  and fails if the result is outside CCbigguy64_MINBIGGUY ..              */
+/*  CCbigguy64_MAXBIGGUY.                                                   */
+/*                                                                          */
+/*    EXPORTED FUNCTIONS:                                                   */
+/*                                                                          */
+/*  CCbigguy128 CCbigguy64_to128 (CCbigguy64 x)                             */
+/*    Returns x.                                                            */
+/*                                                                          */
+/*  void CCbigguy64_to128_array (const CCbigguy64 *x, CCbigguy128 *y,       */
+/*      int n)                                                              */
+/*    y[i] = x[i], for i < n.                                               */
+/*                                                                          */
+/*  int CCbigguy128_to64_chk (CCbigguy128 x, CCbigguy64 *y, int round)      */
+/*    Sets y to x, rounded, and returns 0, or returns 1 (leaving y          */
+/*    unchanged) if that does not fit in a CCbigguy64.                      */
+/*                                                                          */
+/*  CCbigguy64 CCbigguy128_to64 (CCbigguy128 x, int round)                  */
+/*    Returns x, rounded.  If it does not fit, an error message is output   */
+/*    and the routine aborts.                                               */
+/*                                                                          */
+/*  int CCbigguy128_to64_array (const CCbigguy128 *x, CCbigguy64 *y, int n, */
+/*      int round)                                                          */
+/*    y[i] = x[i], rounded, for i < n.  Returns 1 if some x[i] does not     */
+/*    fit (that y[i] is left unchanged, and the others are converted),      */
+/*    and 0 otherwise.                                                      */
+/*                                                                          */
+/****************************************************************************/
+
+/* CCbigguy is CCbigguy128 here whatever CC_BIGGUY_LONGLONG says */
+#undef CC_BIGGUY_LONGLONG
+#undef CC_BIGGUY_LONG
+
+#include "machdefs.h"
+#include "util.h"
+#include "bigguy.h"
+
+static inline CCbigguy128 to128 (CCbigguy64 x)
+{
+    CCbigguy128 y;
+
+    y.ihi = (unsigned int) (x >> 63);
+    y.ilo = (unsigned int) (x >> 32);
+    y.fhi = (unsigned int) x;
+    y.flo = 0;
+    return y;
+}
+
+/* The value in units of 2^-32 is hi * 2^32 + x.fhi + x.flo * 2^-32, with */
+/* hi = x.ihi:x.ilo; it can only fit if hi fits in 32 bits.               */
+
+static inline int to64 (CCbigguy128 x, CCbigguy64 *y, int round)
+{
+    long long hi = (long long) (((unsigned long long) x.ihi << 32) | x.ilo);
+    unsigned int rem = x.flo;
+    long long r;
+    int up;
+
+    if (hi < -2147483647LL - 1 || hi > 2147483647LL) return 1;
+    r = (long long) (((unsigned long long) hi << 32) | x.fhi);
+
+    switch (round) {
+    case CCbigguy_ROUND_CEIL:
+        up = (rem != 0);
+        break;
+    case CCbigguy_ROUND_TRUNC:
+        up = (rem != 0 && r < 0);
+        break;
+    case CCbigguy_ROUND_NEAREST:
+        up = (rem > 0x80000000u || (rem == 0x80000000u && (r & 1)));
+        break;
+    default:
+        up = 0;
+        break;
+    }
+    if (up) {
+        if (r == CCbigguy64_MAXBIGGUY) return 1;
+        r++;
+    }
+    if (r < CCbigguy64_MINBIGGUY) return 1;
+
+    *y = r;
+    return 0;
+}
+
+CCbigguy128 CCbigguy64_to128 (CCbigguy64 x)
+{
+    return to128 (x);
+}
+
+void CCbigguy64_to128_array (const CCbigguy64 *x, CCbigguy128 *y, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++) y[i] = to128 (x[i]);
+}
+
+int CCbigguy128_to64_chk (CCbigguy128 x, CCbigguy64 *y, int round)
+{
+    return to64 (x, y, round);
+}
+
+CCbigguy64 CCbigguy128_to64 (CCbigguy128 x, int round)
+{
+    CCbigguy64 y = 0;
+
+    if (CCbigguy_UNLIKELY (to64 (x, &y, round))) {
+        CCbigguy_overflow ("CCbigguy128_to64");
+    }
+    return y;
+}
+
+int CCbigguy128_to64_array (const CCbigguy128 *x, CCbigguy64 *y, int n,
+        int round)
+{
+    int i, ovf = 0;
+
+    for (i = 0; i < n; i++) ovf |= to64 (x[i], &y[i], round);
+    return ovf;
+}
@@ -33,6 +33,8 @@
 /*  x -= y                  CCbigguy_sub (CCbigguy *x, CCbigguy y)          */
 /*  x += y*m                CCbigguy_addmult (CCbigguy *x, CCbigguy y,      */
 /*                                            int m)                        */
+/*  x += y*m                CCbigguy_addmult_ll (CCbigguy *x, CCbigguy y,   */
+/*                                               long long m)               */
 /*  x<y -1, x==y 0, x>y 1   CCbigguy_cmp (CCbigguy x, CCbigguy y)           */
 /*  ceil(x)                 CCbigguy_ceil (CCbigguy x)                      */
 /*                                                                          */
@@ -57,45 +59,139 @@
 /*  int CCbigguy_sread (CC_SFILE *f, CCbigguy *x)                           */
 /*    NONE                                                                  */
 /*                                                                          */
+/*  int CCbigguy_swrite_array (CC_SFILE *f, const CCbigguy *x, int n)      */
+/*  int CCbigguy_sread_array (CC_SFILE *f, CCbigguy *x, int n)              */
+/*    Write or read x[0..n-1].  The bytes are those of n calls to           */
+/*    CCbigguy_swrite/CCbigguy_sread, so the two forms can be mixed, but    */
+/*    they are converted in blocks and passed through CCutil_swrite and     */
+/*    CCutil_sread a block at a time.                                       */
+/*                                                                          */
 /*  void CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m)                  */
-/*    If an overflow occurs, an error message is output and the routine     */
-/*    aborts.  If CC_BIGGUY_BUILTIN is defined, this is implemented by a    */
-/*    macro, and has no overflow checking.                                  */
+/*  void CCbigguy_addmult_ll (CCbigguy *x, CCbigguy y, long long m)         */
+/*    x += y*m, as one 64x128-bit multiply-accumulate with a single         */
+/*    overflow check; the int form just widens m.  If an overflow occurs,   */
+/*    an error message is output and the routine aborts.  If                */
+/*    CC_BIGGUY_BUILTIN is defined, these are implemented by macros, and    */
+/*    have no overflow checking.                                            */
+/*                                                                          */
+/*  void CCbigguy_add (CCbigguy *x, CCbigguy y)                             */
+/*  void CCbigguy_sub (CCbigguy *x, CCbigguy y)                             */
+/*    A single carry chain with no multiplies.  If an overflow occurs, an   */
+/*    error message is output and the routine aborts.  If                   */
+/*    CC_BIGGUY_BUILTIN is defined, these are implemented by macros, and    */
+/*    have no overflow checking.                                            */
 /*                                                                          */
 /*  int CCbigguy_cmp (CCbigguy x, CCbigguy y)                               */
 /*    If CC_BIGGUY_BUILTIN is defined, this is implemented by a macro,      */
 /*    and has no overflow checking.                                         */
 /*                                                                          */
-/*  double CCbigguytod (CCbigguy x)                                         */
-/*    If CC_BIGGUY_BUILTIN is defined, this is implemented by a macro,      */
-/*    and has no overflow checking.                                         */
+/*  double CCbigguy_bigguytod (CCbigguy x)                                  */
+/*    x rounded to the nearest double (ties to even).  If                   */
+/*    CC_BIGGUY_BUILTIN is defined, this is implemented by a macro, and     */
+/*    has no overflow checking.                                             */
 /*                                                                          */
 /*  CCbigguy CCbigguy_itobigguy (int d)                                     */
-/*    If CC_BIGGUY_BUILTIN is defined, this is implemented by a macro,      */
-/*    and has no overflow checking.                                         */
+/*    Exact for every int.  If CC_BIGGUY_BUILTIN is defined, this is        */
+/*    implemented by a macro, and has no overflow checking.                 */
 /*                                                                          */
 /*  CCbigguy CCbigguy_dtobigguy (double d)                                  */
-/*    If an overflow occurs, an error message is output and the routine     */
-/*    aborts.  If CC_BIGGUY_BUILTIN is defined, this is implemented by a    */
-/*    macro, and has no overflow checking.                                  */
+/*    d rounded to the nearest multiple of 2^-64 (ties to even), so every   */
+/*    double in range with no bits below 2^-64 is converted exactly.  The   */
+/*    range is |d| < 2^63.  If an overflow occurs, an error message is      */
+/*    output and the routine aborts.  If CC_BIGGUY_BUILTIN is defined,      */
+/*    this is implemented by a macro, and has no overflow checking.         */
+/*                                                                          */
+/*  int CCbigguy_dtobigguy_array (const double *d, CCbigguy *x, int n)      */
+/*  void CCbigguy_bigguytod_array (const CCbigguy *x, double *d, int n)     */
+/*    x[i] = (bigguy) d[i] and d[i] = (double) x[i], for i < n.  The first  */
+/*    returns 1 if some d[i] is out of range (that x[i] is left unchanged,  */
+/*    and the others are converted), and 0 otherwise.                       */
 /*                                                                          */
 /*  CCbigguy CCbigguy_ceil (CCbigguy x)                                     */
 /*    If an overflow occurs, an error message is output and the routine     */
 /*    aborts.  If CC_BIGGUY_BUILTIN is defined, this is implemented by a    */
 /*    macro, and has no overflow checking.                                  */
 /*                                                                          */
+/*  int CCbigguy_add_chk (CCbigguy *x, CCbigguy y)                          */
+/*  int CCbigguy_sub_chk (CCbigguy *x, CCbigguy y)                          */
+/*  int CCbigguy_addmult_chk (CCbigguy *x, CCbigguy y, int m)               */
+/*  int CCbigguy_addmult_ll_chk (CCbigguy *x, CCbigguy y, long long m)      */
+/*  int CCbigguy_ceil_chk (CCbigguy *x)                                     */
+/*  int CCbigguy_dtobigguy_chk (double d, CCbigguy *x)                      */
+/*    Non-aborting versions of the above.  They return 0, or 1 if the       */
+/*    result overflows, in which case x is left unchanged.  A batch of      */
+/*    operations can collect a sticky flag with ovf |= ..., and be redone   */
+/*    at higher precision if ovf is set at the end.                         */
+/*                                                                          */
+/*  void CCbigguy_overflow (const char *where)                              */
+/*    Reports an overflow in the named routine and aborts.  This is the     */
+/*    only error path of the aborting routines, and is kept out of line.    */
+/*                                                                          */
 /*  If CC_BIGGUY_BUILTIN is defined, CC_BIGGUY will support up to 64        */
 /*  bits (32 bits on both sides of the decimal).                            */
 /*                                                                          */
+/*  The routines above are exported as CCbigguy128_* (this file is always   */
+/*  built with CCbigguy = CCbigguy128).  The CCbigguy64 forms of sread,     */
+/*  swrite, their _array versions and the two _array conversions are also   */
+/*  built here, so both widths can be used in one program; bigguy.h points  */
+/*  the CCbigguy_* names at one of them (CCbigguy128 unless                 */
+/*  CC_BIGGUY_LONGLONG is defined), and the other CCbigguy64 operations     */
+/*  are macros.  The conversions between the two are in bg_width.c.         */
+/*                                                                          */
+/*  If CC_BIGGUY_INT128 is defined (and the compiler provides __int128),    */
+/*  the add, sub, addmult, cmp and ceil routines treat the value as         */
+/*  two 64-bit limbs, using native 64x64 multiplies and the carry and       */
+/*  overflow flags for the carry chain and the overflow tests.  The         */
+/*  CCbigguy structure, the API and the sread/swrite format are unchanged.  */
+/*                                                                          */
+/*  If CC_BIGGUY_INLINE is defined, bigguy.h turns add, sub, addmult, cmp  */
+/*  and ceil (and their _chk forms) into the static inline versions in      */
+/*  bg_inline.h.  The routines above are still exported from this file.    */
+/*                                                                          */
+/*  Unless CC_BIGGUY_BUILTIN is defined, CCbigguy_addmult and the two       */
+/*  _array conversions are built in bg_cpu.c, which picks the fastest       */
+/*  version this CPU can run when the program starts.                       */
+/*                                                                          */
+/*  If CC_BIGGUY_STATS is defined, the routines count their calls, carries  */
+/*  and results for CCbigguy_stats_get (bg_stats.c).                        */
+/*                                                                          */
 /****************************************************************************/
 
+/* the exported symbols are always built, whatever CC_BIGGUY_INLINE says, */
+/* and CCbigguy is CCbigguy128 here whatever CC_BIGGUY_LONGLONG says       */
+#undef CC_BIGGUY_INLINE
+#undef CC_BIGGUY_LONGLONG
+#undef CC_BIGGUY_LONG
+
 #include "machdefs.h"
 #include "util.h"
 #include "bigguy.h"
+#include "bg_inline.h"
 
-#ifdef  CC_BIGGUY_BUILTIN
+/* The wire format is big-endian.  Written out byte by byte, these compile */
+/* to a single load or store plus a byte swap, and the pack and unpack     */
+/* loops below vectorize.                                                  */
 
-int CCbigguy_swrite (CC_SFILE *f, CCbigguy x)
+#define BIGGUY_PUT32(p,v) {                                             \
+    (p)[0] = (unsigned char) ((v) >> 24);                               \
+    (p)[1] = (unsigned char) ((v) >> 16);                               \
+    (p)[2] = (unsigned char) ((v) >> 8);                                \
+    (p)[3] = (unsigned char) (v);                                       \
+}
+#define BIGGUY_GET32(p) (((unsigned int) (p)[0] << 24) |                 \
+                         ((unsigned int) (p)[1] << 16) |                 \
+                         ((unsigned int) (p)[2] << 8) |                  \
+                          (unsigned int) (p)[3])
+
+#define BIGGUY_BLOCK 256
+
+static void
+    bigguy_pack (unsigned char *p, const CCbigguy *x, int n),
+    bigguy_unpack (const unsigned char *p, CCbigguy *x, int n),
+    bigguy64_pack (unsigned char *p, const CCbigguy64 *x, int n),
+    bigguy64_unpack (const unsigned char *p, CCbigguy64 *x, int n);
+
+int CCbigguy64_swrite (CC_SFILE *f, CCbigguy64 x)
 {
     if (CCutil_swrite_ushort (f, (unsigned short) ((x>>48)&0xffff))) return -1;
     if (CCutil_swrite_ushort (f, (unsigned short) ((x>>32)&0xffff))) return -1;
@@ -105,62 +201,100 @@ int CCbigguy_swrite (CC_SFILE *f, CCbigguy x)
     return 0;
 }
 
-int CCbigguy_sread (CC_SFILE *f, CCbigguy *x)
+int CCbigguy64_sread (CC_SFILE *f, CCbigguy64 *x)
 {
     unsigned short y;
 
     if (CCutil_sread_ushort (f, &y)) return -1;
-    *x = ((CCbigguy) y) << 48;
+    *x = ((CCbigguy64) y) << 48;
     if (CCutil_sread_ushort (f, &y)) return -1;
-    *x |= ((CCbigguy) y) << 32;
+    *x |= ((CCbigguy64) y) << 32;
     if (CCutil_sread_ushort (f, &y)) return -1;
-    *x |= ((CCbigguy) y) << 16;
+    *x |= ((CCbigguy64) y) << 16;
     if (CCutil_sread_ushort (f, &y)) return -1;
-    *x |= ((CCbigguy) y);
+    *x |= ((CCbigguy64) y);
     return 0;
 }
 
-#else  /* CC_BIGGUY_BUILTIN */
+#define BIGGUY64_WIRESIZE 8
+
+static void bigguy64_pack (unsigned char *p, const CCbigguy64 *x, int n)
+{
+    unsigned long long v;
+    int i;
+
+    for (i = 0; i < n; i++, p += BIGGUY64_WIRESIZE) {
+        v = (unsigned long long) x[i];
+        BIGGUY_PUT32 (p, (unsigned int) (v >> 32));
+        BIGGUY_PUT32 (p + 4, (unsigned int) v);
+    }
+}
+
+static void bigguy64_unpack (const unsigned char *p, CCbigguy64 *x, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++, p += BIGGUY64_WIRESIZE) {
+        x[i] = (CCbigguy64) (((unsigned long long) BIGGUY_GET32 (p) << 32) |
+                             BIGGUY_GET32 (p + 4));
+    }
+}
+
+int CCbigguy64_swrite_array (CC_SFILE *f, const CCbigguy64 *x, int n)
+{
+    unsigned char buf[BIGGUY_BLOCK * BIGGUY64_WIRESIZE];
+    int k;
+
+    while (n > 0) {
+        k = (n < BIGGUY_BLOCK) ? n : BIGGUY_BLOCK;
+        bigguy64_pack (buf, x, k);
+        if (CCutil_swrite (f, (char *) buf, k * BIGGUY64_WIRESIZE)) return -1;
+        x += k;
+        n -= k;
+    }
+    return 0;
+}
+
+int CCbigguy64_sread_array (CC_SFILE *f, CCbigguy64 *x, int n)
+{
+    unsigned char buf[BIGGUY_BLOCK * BIGGUY64_WIRESIZE];
+    int k;
+
+    while (n > 0) {
+        k = (n < BIGGUY_BLOCK) ? n : BIGGUY_BLOCK;
+        if (CCutil_sread (f, (char *) buf, k * BIGGUY64_WIRESIZE)) return -1;
+        bigguy64_unpack (buf, x, k);
+        x += k;
+        n -= k;
+    }
+    return 0;
+}
+
+int CCbigguy64_dtobigguy_array (const double *d, CCbigguy64 *x, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++) x[i] = CCbigguy64_dtobigguy (d[i]);
+    return 0;
+}
+
+void CCbigguy64_bigguytod_array (const CCbigguy64 *x, double *d, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++) d[i] = CCbigguy64_bigguytod (x[i]);
+}
 
 const CCbigguy CCbigguy_MINBIGGUY = {0x80000000,0x00000000,0x00000000,0x00000001};
 const CCbigguy CCbigguy_MAXBIGGUY = {0x7fffffff,0xffffffff,0xffffffff,0xffffffff};
 const CCbigguy CCbigguy_ZERO = {0,0,0,0};
 const CCbigguy CCbigguy_ONE = {0,1,0,0};
 
-static void
-    bigguy_neg (CCbigguy *x);
-
-static void bigguy_neg (CCbigguy *x)
+void CCbigguy_overflow (const char *where)
 {
-    x->ihi = ((unsigned int) BIT_32_UMAX) - (unsigned int) x->ihi;
-    x->ilo = ((unsigned int) BIT_32_UMAX) - (unsigned int) x->ilo;
-    x->fhi = ((unsigned int) BIT_32_UMAX) - (unsigned int) x->fhi;
-    x->flo = ((unsigned int) BIT_32_UMAX) - (unsigned int) x->flo;
-
-    if ((unsigned int) x->flo < BIT_32_UMAX) {
-        x->flo = (unsigned int) x->flo + 1;
-    } else {
-        x->flo = 0;
-        if ((unsigned int) x->fhi < BIT_32_UMAX) {
-            x->fhi = (unsigned int) x->fhi + 1;
-        } else {
-            x->fhi = 0;
-            if ((unsigned int) x->ilo < BIT_32_UMAX) {
-                x->ilo = (unsigned int) x->ilo + 1;
-            } else {
-                x->ilo = 0;
-                if ((unsigned int) x->ihi == BIT_32_SMAX) {
-                    fprintf (stderr, "OVERFLOW in bigguy_neg\n");
-                    fprintf (stderr, "BIGGUY errors are fatal\n");
-                    abort ();
-                } else if ((unsigned int) x->ihi < BIT_32_UMAX) {
-                    x->ihi = (unsigned int) x->ihi + 1;
-                } else {
-                    x->ihi = 0;
-                }
-            }
-        }
-    }
+    fprintf (stderr, "OVERFLOW in %s\n", where);
+    fprintf (stderr, "BIGGUY errors are fatal\n");
+    abort ();
 }
 
 int CCbigguy_swrite (CC_SFILE *f, CCbigguy x)
@@ -182,225 +316,176 @@ int CCbigguy_sread (CC_SFILE *f, CCbigguy *x)
     return 0;
 }
 
-double CCbigguy_bigguytod (CCbigguy x)
+#define BIGGUY_WIRESIZE 16
+
+static void bigguy_pack (unsigned char *p, const CCbigguy *x, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++, p += BIGGUY_WIRESIZE) {
+        BIGGUY_PUT32 (p, x[i].ihi);
+        BIGGUY_PUT32 (p + 4, x[i].ilo);
+        BIGGUY_PUT32 (p + 8, x[i].fhi);
+        BIGGUY_PUT32 (p + 12, x[i].flo);
+    }
+}
+
+static void bigguy_unpack (const unsigned char *p, CCbigguy *x, int n)
 {
-    int sgn = 1;
+    int i;
 
-    if ((unsigned int) x.ihi >= 2147483648) {
-        bigguy_neg (&x);
-        sgn = -1;
+    for (i = 0; i < n; i++, p += BIGGUY_WIRESIZE) {
+        x[i].ihi = BIGGUY_GET32 (p);
+        x[i].ilo = BIGGUY_GET32 (p + 4);
+        x[i].fhi = BIGGUY_GET32 (p + 8);
+        x[i].flo = BIGGUY_GET32 (p + 12);
     }
+}
 
-    return sgn * (((double) x.ihi) * (BIT_32_UMAXF+1) +
-                  ((double) x.ilo) +
-                  ((double) x.fhi) / (BIT_32_UMAXF+1) +
-                  ((double) x.flo) / ((BIT_32_UMAXF+1)*(BIT_32_UMAXF+1)));
+double CCbigguy_bigguytod (CCbigguy x)
+{
+    CCbigguy_STATS_CALLS (CCbigguy_STAT_BIGGUYTOD, 1);
+    return CCbigguy_inline_bigguytod (x);
 }
 
-// note that this function will report an overflow in int,
-// not in bigguy.
 CCbigguy CCbigguy_itobigguy (int d)
 {
     CCbigguy x;
-    int sgn;
-
-    if (d < 0) {
-        d = -d;
-        sgn = -1;
-    } else {
-        sgn = 1;
-    }
 
-    if (d < 0 || (d >> 16) >= 32768) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_itobigguy\n");
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        fprintf (stderr, "An overflowed integer was passed in\n");
-        abort ();
-    }
-    x.ihi = ((unsigned int) (0x00000000));
-    x.ilo = ((unsigned int) (d & 0xffffffff));
+    x.ihi = (d < 0) ? BIT_32_UMAX : 0;
+    x.ilo = (unsigned int) d;
     x.fhi = 0;
     x.flo = 0;
 
-    if (sgn == -1) {
-        bigguy_neg (&x);
-    }
     return x;
 }
 
+int CCbigguy_dtobigguy_chk (double d, CCbigguy *y)
+{
+    int r = CCbigguy_inline_dtobigguy_chk (d, y);
+
+    CCbigguy_STATS_RESULT (CCbigguy_STAT_DTOBIGGUY,
+                           r ? (CCbigguy *) NULL : y, 1);
+    return r;
+}
+
+static void dtobigguy_overflow (double d) CCbigguy_COLD;
+
+static void dtobigguy_overflow (double d)
+{
+    fprintf (stderr, "OVERFLOW in CCbigguy_dtobigguy (%.6f)\n", d);
+    fprintf (stderr, "BIGGUY errors are fatal\n");
+    abort ();
+}
+
 CCbigguy CCbigguy_dtobigguy (double d)
 {
     CCbigguy x;
-    int sgn;
 
-    if (d < 0.0) {
-        d = -d;
-        sgn = -1;
-    } else {
-        sgn = 1;
+    if (CCbigguy_UNLIKELY (CCbigguy_dtobigguy_chk (d, &x))) {
+        dtobigguy_overflow (d);
     }
+    return x;
+}
 
-    if (d / (BIT_32_UMAXF+1) >= (BIT_32_SMAXF+1)) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_dtobigguy (%.6f)\n", d * sgn);
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        abort ();
-    }
+/* for the statistics, the ceiling adds 1 to the floor if there is a */
+/* fraction                                                           */
 
-    x.ihi = ((unsigned int) (d / (BIT_32_UMAXF+1)));
-    d -= ((double) x.ihi) * (BIT_32_UMAXF+1);
-    x.ilo = ((unsigned int) d);
-    d -= ((double) x.ilo);
-    x.fhi = ((unsigned int) (d * (BIT_32_UMAXF+1)));
-    d -= ((double) x.fhi) / (BIT_32_UMAXF+1);
-    x.flo = ((unsigned int) (d * (BIT_32_UMAXF+1) * (BIT_32_UMAXF+1)));
+#ifdef CC_BIGGUY_STATS
+#define STATS_CEIL(x,ovf) {                                             \
+    long long frac = (stats_old.fhi | stats_old.flo) != 0;              \
+    stats_old.fhi = stats_old.flo = 0;                                  \
+    CCbigguy_STATS_ARITH (CCbigguy_STAT_CEIL, x, CCbigguy_ONE, frac,    \
+                          ovf);                                         \
+}
+#else
+#define STATS_CEIL(x,ovf)
+#endif
 
-    if (sgn == -1) {
-        bigguy_neg (&x);
-    }
+int CCbigguy_ceil_chk (CCbigguy *x)
+{
+    CCbigguy_STATS_SAVE (x)
+    int r = CCbigguy_inline_ceil_chk (x);
 
-    return x;
+    STATS_CEIL (x, r);
+    return r;
 }
 
-CCbigguy CCbigguy_ceil (CCbigguy x)
+int CCbigguy_cmp (CCbigguy x, CCbigguy y)
 {
-    if ((unsigned int) x.fhi || (unsigned int) x.flo) {
-        x.fhi = 0;
-        x.flo = 0;
-        x.ilo = (unsigned int) x.ilo + 1;
-        if ((unsigned int) x.ilo == 0) {
-            if ((unsigned int) x.ihi == BIT_32_SMAX) {
-                fprintf (stderr, "OVERFLOW in CCbigguy_ceil\n");
-                fprintf (stderr, "BIGGUY errors are fatal\n");
-                abort ();
-            }
-            x.ihi = (unsigned int) x.ihi + 1;
-        }
-    }
+    CCbigguy_STATS_CALLS (CCbigguy_STAT_CMP, 1);
+    return CCbigguy_inline_cmp (x, y);
+}
 
-    return x;
+int CCbigguy_add_chk (CCbigguy *x, CCbigguy y)
+{
+    CCbigguy_STATS_SAVE (x)
+    int r = CCbigguy_inline_add_chk (x, y);
+
+    CCbigguy_STATS_ARITH (CCbigguy_STAT_ADD, x, y, 1, r);
+    return r;
 }
 
-int CCbigguy_cmp (CCbigguy x, CCbigguy y)
+int CCbigguy_sub_chk (CCbigguy *x, CCbigguy y)
 {
-    if ((unsigned int) x.ihi >= 2147483648 && (unsigned int) y.ihi < 2147483648) return -1;
-    else if ((unsigned int) x.ihi < 2147483648 && (unsigned int) y.ihi >= 2147483648) return 1;
-    else if ((unsigned int) x.ihi < (unsigned int) y.ihi) return -1;
-    else if ((unsigned int) x.ihi > (unsigned int) y.ihi) return 1;
-    else if ((unsigned int) x.ilo < (unsigned int) y.ilo) return -1;
-    else if ((unsigned int) x.ilo > (unsigned int) y.ilo) return 1;
-    else if ((unsigned int) x.fhi < (unsigned int) y.fhi) return -1;
-    else if ((unsigned int) x.fhi > (unsigned int) y.fhi) return 1;
-    else if ((unsigned int) x.flo < (unsigned int) y.flo) return -1;
-    else if ((unsigned int) x.flo > (unsigned int) y.flo) return 1;
-    else return 0;
+    CCbigguy_STATS_SAVE (x)
+    int r = CCbigguy_inline_sub_chk (x, y);
+
+    CCbigguy_STATS_ARITH (CCbigguy_STAT_SUB, x, y, -1, r);
+    return r;
 }
 
-void CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m)
+void CCbigguy_add (CCbigguy *x, CCbigguy y)
 {
-    long int carry = 0;
-    int sgn;
-    int oldsgn;
-    long int mlo;
-    long int mhi;
-
-    if (m == -m && m != 0) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_addmult (1)\n");
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        abort ();
-    }
+    CCbigguy_STATS_SAVE (x)
 
-    if ((unsigned int) y.ihi >= 2147483648) {
-        bigguy_neg (&y);
-        m = -m;
-    }
+    CCbigguy_inline_add (x, y);
+    CCbigguy_STATS_ARITH (CCbigguy_STAT_ADD, x, y, 1, 0);
+}
 
-    mhi = m / (BIT_32_UMAX+1);
-    mlo = m - mhi*(BIT_32_UMAX+1);
-    if (mlo < -2147483648) {
-        mlo += (BIT_32_UMAX+1);
-        mhi--;
-    }
-    if (mlo > BIT_32_SMAX) {
-        mlo -= (BIT_32_UMAX+1);
-        mhi++;
-    }
-    if (mlo < -2147483648 || mlo > BIT_32_SMAX) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_addmult (2)\n");
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        abort ();
-    }
-    if (mhi < -2147483648 || mhi > BIT_32_SMAX) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_addmult (3)\n");
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        abort ();
-    }
+void CCbigguy_sub (CCbigguy *x, CCbigguy y)
+{
+    CCbigguy_STATS_SAVE (x)
 
-    if ((unsigned int) x->ihi >= 2147483648) {
-        oldsgn = -1;
-    } else {
-        oldsgn = 1;
-    }
+    CCbigguy_inline_sub (x, y);
+    CCbigguy_STATS_ARITH (CCbigguy_STAT_SUB, x, y, -1, 0);
+}
 
-    carry = (unsigned long int) x->flo + mlo * (unsigned long int) y.flo;
-    x->flo = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->flo;
-    carry /= (BIT_32_UMAX+1);
-    carry = carry + (unsigned long int) x->fhi + mlo * (unsigned long int) y.fhi;
-    x->fhi = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->fhi;
-    carry /= (BIT_32_UMAX+1);
-    carry = carry + (unsigned long int) x->ilo + mlo * (unsigned long int) y.ilo;
-    x->ilo = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->ilo;
-    carry /= (BIT_32_UMAX+1);
-    carry = carry + (unsigned long int) x->ihi + mlo * (unsigned long int) y.ihi;
-    x->ihi = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->ihi;
-    carry /= (BIT_32_UMAX+1);
-
-    if ((unsigned long int) x->ihi >= 2147483648) {
-        sgn = -1;
-    } else {
-        sgn = 1;
-    }
-    if (carry < -1 || carry > 1 ||
-        (carry == -1 && !(oldsgn == 1 && sgn == -1)) ||
-        (carry == 0 && oldsgn != sgn) ||
-        (carry == 1 && !(oldsgn == -1 && sgn == 1))) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_addmult (4)\n");
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        abort ();
-    }
+CCbigguy CCbigguy_ceil (CCbigguy x)
+{
+    CCbigguy_STATS_SAVE (&x)
 
-    oldsgn = sgn;
-
-    carry = (unsigned long int) x->fhi + mhi * (unsigned long int) y.flo;
-    x->fhi = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->fhi;
-    carry /= (BIT_32_UMAX+1);
-    carry = carry + (unsigned long int) x->ilo + mhi * (unsigned long int) y.fhi;
-    x->ilo = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->ilo;
-    carry /= (BIT_32_UMAX+1);
-    carry = carry + (unsigned long int) x->ihi + mhi * (unsigned long int) y.ilo;
-    x->ihi = carry & ((unsigned long int) 0xffffffff);
-    carry -= (unsigned long int) x->ihi;
-    carry /= (BIT_32_UMAX+1);
-    carry = carry + mhi * (unsigned long int) y.ihi;
-
-    if ((unsigned long int) x->ihi >= 2147483648) {
-        sgn = -1;
-    } else {
-        sgn = 1;
-    }
-    if (carry < -1 || carry > 1 ||
-        (carry == -1 && !(oldsgn == 1 && sgn == -1)) ||
-        (carry == 0 && oldsgn != sgn) ||
-        (carry == 1 && !(oldsgn == -1 && sgn == 1))) {
-        fprintf (stderr, "OVERFLOW in CCbigguy_addmult (4)\n");
-        fprintf (stderr, "BIGGUY errors are fatal\n");
-        abort ();
+    x = CCbigguy_inline_ceil (x);
+    STATS_CEIL (&x, 0);
+    return x;
+}
+
+int CCbigguy_swrite_array (CC_SFILE *f, const CCbigguy *x, int n)
+{
+    unsigned char buf[BIGGUY_BLOCK * BIGGUY_WIRESIZE];
+    int k;
+
+    while (n > 0) {
+        k = (n < BIGGUY_BLOCK) ? n : BIGGUY_BLOCK;
+        bigguy_pack (buf, x, k);
+        if (CCutil_swrite (f, (char *) buf, k * BIGGUY_WIRESIZE)) return -1;
+        x += k;
+        n -= k;
     }
+    return 0;
 }
 
-#endif /* CC_BIGGUY_BUILTIN */
+int CCbigguy_sread_array (CC_SFILE *f, CCbigguy *x, int n)
+{
+    unsigned char buf[BIGGUY_BLOCK * BIGGUY_WIRESIZE];
+    int k;
+
+    while (n > 0) {
+        k = (n < BIGGUY_BLOCK) ? n : BIGGUY_BLOCK;
+        if (CCutil_sread (f, (char *) buf, k * BIGGUY_WIRESIZE)) return -1;
+        bigguy_unpack (buf, x, k);
+        x += k;
+        n -= k;
+    }
+    return 0;
+}
@@ -23,75 +23,522 @@
 
 #include "util.h"
 
-#undef CC_BIGGUY_LONG
-#undef CC_BIGGUY_LONGLONG
-
-#ifdef  CC_BIGGUY_LONGLONG
-typedef long long CCbigguy;
-#define CC_BIGGUY_BUILTIN
+#ifdef __GNUC__
+#define CCbigguy_UNLIKELY(x) __builtin_expect (!!(x), 0)
+#define CCbigguy_COLD __attribute__ ((cold, noinline, noreturn))
+#define CCbigguy_ALIGN16 __attribute__ ((aligned (16)))
+#else
+#define CCbigguy_UNLIKELY(x) (x)
+#define CCbigguy_COLD
+#define CCbigguy_ALIGN16
 #endif
 
-#ifdef CC_BIGGUY_LONG
-typedef long CCbigguy;
-#define CC_BIGGUY_BUILTIN
-#endif
+typedef struct CCbigguy_pool CCbigguy_pool;
+
+int
+    CCbigguy_pool_init (CCbigguy_pool **pool, int nthreads),
+    CCbigguy_pool_nthreads (const CCbigguy_pool *pool);
+
+void
+    CCbigguy_pool_free (CCbigguy_pool *pool),
+    CCbigguy_pool_run (CCbigguy_pool *pool, int ntasks,
+        void (*task) (void *arg, int i), void *arg);
 
-#ifdef CC_BIGGUY_BUILTIN
-#define CCbigguy_FRACBITS 32
-#define CCbigguy_DUALSCALE (((CCbigguy) 1) << CCbigguy_FRACBITS)
-#define CCbigguy_FRACPART(x) ((x) & (CCbigguy_DUALSCALE-1))
-#define CCbigguy_MAXBIGGUY (((((CCbigguy) 1) << 62) - 1) + \
-                            (((CCbigguy) 1) << 62))
-#define CCbigguy_MINBIGGUY (-CCbigguy_MAXBIGGUY)
-#define CCbigguy_bigguytod(x) (((double) (x)) / ((double) CCbigguy_DUALSCALE))
-#define CCbigguy_itobigguy(d) ((CCbigguy) ((d) * (double) CCbigguy_DUALSCALE))
-#define CCbigguy_ceil(x) (CCbigguy_FRACPART(x) ? \
-        ((x) + (CCbigguy_DUALSCALE - CCbigguy_FRACPART(x))) : (x))
-#define CCbigguy_cmp(x,y) (((x) < (y)) ? -1 : ((x) > (y)) ? 1 : 0)
-#define CCbigguy_ZERO ((CCbigguy) 0)
-#define CCbigguy_ONE ((CCbigguy) CCbigguy_DUALSCALE)
-#define CCbigguy_addmult(x,y,m) ((*x) += (y)*(m))
-#define CCbigguy_dtobigguy(d) ((CCbigguy) ((d) * (double) CCbigguy_DUALSCALE))
-
-#else /* CC_BIGGUY_BUILTIN */
-
-typedef struct CCbigguy {
+/* Two representations are always available.  CCbigguy64 is a 32.32       */
+/* fixed-point long long whose operations are macros with no overflow     */
+/* checks, for cheap short-lived values.  CCbigguy128 is the 64.64         */
+/* fixed-point struct whose operations check every overflow.  CCbigguy    */
+/* and the CCbigguy_* names stand for one of the two: CCbigguy128 unless  */
+/* CC_BIGGUY_LONGLONG (or CC_BIGGUY_LONG) is defined, in which case they  */
+/* are CCbigguy64 and CC_BIGGUY_BUILTIN is defined.  The library routines */
+/* beyond the ones below (vec, wide, par, ...) exist only for the         */
+/* CCbigguy128 alias, and the library and its callers must agree on the  */
+/* alias.  With the CCbigguy128 alias, bg_compat.c also exports the       */
+/* CCbigguy_* names themselves, for objects built with the older header. */
+
+typedef long long CCbigguy64;
+
+#define CCbigguy64_FRACBITS 32
+#define CCbigguy64_DUALSCALE (((CCbigguy64) 1) << CCbigguy64_FRACBITS)
+#define CCbigguy64_FRACPART(x) ((x) & (CCbigguy64_DUALSCALE-1))
+#define CCbigguy64_MAXBIGGUY (((((CCbigguy64) 1) << 62) - 1) + \
+                              (((CCbigguy64) 1) << 62))
+#define CCbigguy64_MINBIGGUY (-CCbigguy64_MAXBIGGUY)
+#define CCbigguy64_bigguytod(x) (((double) (x)) / \
+                                 ((double) CCbigguy64_DUALSCALE))
+#define CCbigguy64_itobigguy(d) ((CCbigguy64) ((d) * \
+                                 (double) CCbigguy64_DUALSCALE))
+#define CCbigguy64_ceil(x) (CCbigguy64_FRACPART(x) ? \
+        ((x) + (CCbigguy64_DUALSCALE - CCbigguy64_FRACPART(x))) : (x))
+#define CCbigguy64_cmp(x,y) (((x) < (y)) ? -1 : ((x) > (y)) ? 1 : 0)
+#define CCbigguy64_ZERO ((CCbigguy64) 0)
+#define CCbigguy64_ONE ((CCbigguy64) CCbigguy64_DUALSCALE)
+#define CCbigguy64_addmult(x,y,m) ((*x) += (y)*(m))
+#define CCbigguy64_addmult_ll(x,y,m) ((*x) += (y)*(m))
+#define CCbigguy64_add(x,y) ((*x) += (y))
+#define CCbigguy64_sub(x,y) ((*x) -= (y))
+#define CCbigguy64_dtobigguy(d) ((CCbigguy64) ((d) * \
+                                 (double) CCbigguy64_DUALSCALE))
+#define CCbigguy64_add_chk(x,y) (CCbigguy64_add(x,y), 0)
+#define CCbigguy64_sub_chk(x,y) (CCbigguy64_sub(x,y), 0)
+#define CCbigguy64_addmult_chk(x,y,m) (CCbigguy64_addmult(x,y,m), 0)
+#define CCbigguy64_addmult_ll_chk(x,y,m) (CCbigguy64_addmult_ll(x,y,m), 0)
+#define CCbigguy64_ceil_chk(x) ((*(x) = CCbigguy64_ceil(*(x))), 0)
+#define CCbigguy64_dtobigguy_chk(d,x) ((*(x) = CCbigguy64_dtobigguy(d)), 0)
+#define CCbigguy64_dot_chk(acc,y,m,n) (CCbigguy64_dot(acc,y,m,n), 0)
+#define CCbigguy64_dot_sparse_chk(acc,y,ind,m,n) \
+        (CCbigguy64_dot_sparse(acc,y,ind,m,n), 0)
+
+typedef struct CCbigguy128 {
     unsigned int ihi;
     unsigned int ilo;
     unsigned int fhi;
     unsigned int flo;
-} CCbigguy;
+} CCbigguy128;
 
-extern const CCbigguy CCbigguy_MINBIGGUY;
-extern const CCbigguy CCbigguy_MAXBIGGUY;
-extern const CCbigguy CCbigguy_ZERO;
-extern const CCbigguy CCbigguy_ONE;
+extern const CCbigguy128 CCbigguy128_MINBIGGUY;
+extern const CCbigguy128 CCbigguy128_MAXBIGGUY;
+extern const CCbigguy128 CCbigguy128_ZERO;
+extern const CCbigguy128 CCbigguy128_ONE;
 
+#define CCbigguy_ROUND_FLOOR   0
+#define CCbigguy_ROUND_CEIL    1
+#define CCbigguy_ROUND_TRUNC   2
+#define CCbigguy_ROUND_NEAREST 3
 
     void
-        CCbigguy_addmult (CCbigguy *x, CCbigguy y, int m);
+        CCbigguy128_addmult (CCbigguy128 *x, CCbigguy128 y, int m),
+        CCbigguy128_addmult_ll (CCbigguy128 *x, CCbigguy128 y, long long m),
+        CCbigguy128_add (CCbigguy128 *x, CCbigguy128 y),
+        CCbigguy128_sub (CCbigguy128 *x, CCbigguy128 y),
+        CCbigguy128_dot (CCbigguy128 *acc, const CCbigguy128 *y,
+            const int *m, int n),
+        CCbigguy128_dot_sparse (CCbigguy128 *acc, const CCbigguy128 *y,
+            const int *ind, const int *m, int n),
+        CCbigguy128_bigguytod_array (const CCbigguy128 *x, double *d, int n);
 
     int
-        CCbigguy_cmp (CCbigguy x, CCbigguy y);
+        CCbigguy128_cmp (CCbigguy128 x, CCbigguy128 y),
+        CCbigguy128_addmult_chk (CCbigguy128 *x, CCbigguy128 y, int m),
+        CCbigguy128_addmult_ll_chk (CCbigguy128 *x, CCbigguy128 y,
+            long long m),
+        CCbigguy128_add_chk (CCbigguy128 *x, CCbigguy128 y),
+        CCbigguy128_sub_chk (CCbigguy128 *x, CCbigguy128 y),
+        CCbigguy128_ceil_chk (CCbigguy128 *x),
+        CCbigguy128_dtobigguy_chk (double d, CCbigguy128 *x),
+        CCbigguy128_dot_chk (CCbigguy128 *acc, const CCbigguy128 *y,
+            const int *m, int n),
+        CCbigguy128_dot_sparse_chk (CCbigguy128 *acc, const CCbigguy128 *y,
+            const int *ind, const int *m, int n),
+        CCbigguy128_dtobigguy_array (const double *d, CCbigguy128 *x, int n),
+        CCbigguy128_swrite (CC_SFILE *f, CCbigguy128 x),
+        CCbigguy128_sread (CC_SFILE *f, CCbigguy128 *x),
+        CCbigguy128_swrite_array (CC_SFILE *f, const CCbigguy128 *x, int n),
+        CCbigguy128_sread_array (CC_SFILE *f, CCbigguy128 *x, int n);
 
     double
-        CCbigguy_bigguytod (CCbigguy x);
+        CCbigguy128_bigguytod (CCbigguy128 x);
+
+    CCbigguy128
+        CCbigguy128_itobigguy (int d),
+        CCbigguy128_dtobigguy (double d),
+        CCbigguy128_ceil (CCbigguy128 x);
+
+    void
+        CCbigguy_overflow (const char *where) CCbigguy_COLD;
+
+    void
+        CCbigguy64_dot (CCbigguy64 *acc, const CCbigguy64 *y, const int *m,
+            int n),
+        CCbigguy64_dot_sparse (CCbigguy64 *acc, const CCbigguy64 *y,
+            const int *ind, const int *m, int n),
+        CCbigguy64_bigguytod_array (const CCbigguy64 *x, double *d, int n);
+
+    int
+        CCbigguy64_dtobigguy_array (const double *d, CCbigguy64 *x, int n),
+        CCbigguy64_swrite (CC_SFILE *f, CCbigguy64 x),
+        CCbigguy64_sread (CC_SFILE *f, CCbigguy64 *x),
+        CCbigguy64_swrite_array (CC_SFILE *f, const CCbigguy64 *x, int n),
+        CCbigguy64_sread_array (CC_SFILE *f, CCbigguy64 *x, int n);
+
+    CCbigguy128
+        CCbigguy64_to128 (CCbigguy64 x);
+
+    CCbigguy64
+        CCbigguy128_to64 (CCbigguy128 x, int round);
+
+    int
+        CCbigguy128_to64_chk (CCbigguy128 x, CCbigguy64 *y, int round),
+        CCbigguy128_to64_array (const CCbigguy128 *x, CCbigguy64 *y, int n,
+            int round);
+
+    void
+        CCbigguy64_to128_array (const CCbigguy64 *x, CCbigguy128 *y, int n);
+
+#if defined(CC_BIGGUY_LONGLONG) || defined(CC_BIGGUY_LONG)
+
+typedef CCbigguy64 CCbigguy;
+#define CC_BIGGUY_BUILTIN
+
+#define CCbigguy_FRACBITS CCbigguy64_FRACBITS
+#define CCbigguy_DUALSCALE CCbigguy64_DUALSCALE
+#define CCbigguy_FRACPART CCbigguy64_FRACPART
+#define CCbigguy_MAXBIGGUY CCbigguy64_MAXBIGGUY
+#define CCbigguy_MINBIGGUY CCbigguy64_MINBIGGUY
+#define CCbigguy_ZERO CCbigguy64_ZERO
+#define CCbigguy_ONE CCbigguy64_ONE
+#define CCbigguy_add CCbigguy64_add
+#define CCbigguy_sub CCbigguy64_sub
+#define CCbigguy_addmult CCbigguy64_addmult
+#define CCbigguy_addmult_ll CCbigguy64_addmult_ll
+#define CCbigguy_cmp CCbigguy64_cmp
+#define CCbigguy_ceil CCbigguy64_ceil
+#define CCbigguy_bigguytod CCbigguy64_bigguytod
+#define CCbigguy_itobigguy CCbigguy64_itobigguy
+#define CCbigguy_dtobigguy CCbigguy64_dtobigguy
+#define CCbigguy_add_chk CCbigguy64_add_chk
+#define CCbigguy_sub_chk CCbigguy64_sub_chk
+#define CCbigguy_addmult_chk CCbigguy64_addmult_chk
+#define CCbigguy_addmult_ll_chk CCbigguy64_addmult_ll_chk
+#define CCbigguy_ceil_chk CCbigguy64_ceil_chk
+#define CCbigguy_dtobigguy_chk CCbigguy64_dtobigguy_chk
+#define CCbigguy_dot CCbigguy64_dot
+#define CCbigguy_dot_sparse CCbigguy64_dot_sparse
+#define CCbigguy_dot_chk CCbigguy64_dot_chk
+#define CCbigguy_dot_sparse_chk CCbigguy64_dot_sparse_chk
+#define CCbigguy_dtobigguy_array CCbigguy64_dtobigguy_array
+#define CCbigguy_bigguytod_array CCbigguy64_bigguytod_array
+#define CCbigguy_swrite CCbigguy64_swrite
+#define CCbigguy_sread CCbigguy64_sread
+#define CCbigguy_swrite_array CCbigguy64_swrite_array
+#define CCbigguy_sread_array CCbigguy64_sread_array
+
+#else  /* CC_BIGGUY_LONGLONG */
+
+typedef CCbigguy128 CCbigguy;
+
+#define CCbigguy_MAXBIGGUY CCbigguy128_MAXBIGGUY
+#define CCbigguy_MINBIGGUY CCbigguy128_MINBIGGUY
+#define CCbigguy_ZERO CCbigguy128_ZERO
+#define CCbigguy_ONE CCbigguy128_ONE
+#define CCbigguy_add CCbigguy128_add
+#define CCbigguy_sub CCbigguy128_sub
+#define CCbigguy_addmult CCbigguy128_addmult
+#define CCbigguy_addmult_ll CCbigguy128_addmult_ll
+#define CCbigguy_cmp CCbigguy128_cmp
+#define CCbigguy_ceil CCbigguy128_ceil
+#define CCbigguy_bigguytod CCbigguy128_bigguytod
+#define CCbigguy_itobigguy CCbigguy128_itobigguy
+#define CCbigguy_dtobigguy CCbigguy128_dtobigguy
+#define CCbigguy_add_chk CCbigguy128_add_chk
+#define CCbigguy_sub_chk CCbigguy128_sub_chk
+#define CCbigguy_addmult_chk CCbigguy128_addmult_chk
+#define CCbigguy_addmult_ll_chk CCbigguy128_addmult_ll_chk
+#define CCbigguy_ceil_chk CCbigguy128_ceil_chk
+#define CCbigguy_dtobigguy_chk CCbigguy128_dtobigguy_chk
+#define CCbigguy_dot CCbigguy128_dot
+#define CCbigguy_dot_sparse CCbigguy128_dot_sparse
+#define CCbigguy_dot_chk CCbigguy128_dot_chk
+#define CCbigguy_dot_sparse_chk CCbigguy128_dot_sparse_chk
+#define CCbigguy_dtobigguy_array CCbigguy128_dtobigguy_array
+#define CCbigguy_bigguytod_array CCbigguy128_bigguytod_array
+#define CCbigguy_swrite CCbigguy128_swrite
+#define CCbigguy_sread CCbigguy128_sread
+#define CCbigguy_swrite_array CCbigguy128_swrite_array
+#define CCbigguy_sread_array CCbigguy128_sread_array
+
+#endif /* CC_BIGGUY_LONGLONG */
+
+#ifndef CC_BIGGUY_BUILTIN
+
+typedef struct CCbigguy_wide {
+    long long lane[6];
+    int pending;
+} CCbigguy_wide;
+
+    void
+        CCbigguy_wide_init (CCbigguy_wide *w, CCbigguy x),
+        CCbigguy_wide_addmult (CCbigguy_wide *w, const CCbigguy *y, int m),
+        CCbigguy_wide_dot (CCbigguy_wide *w, const CCbigguy *y, const int *m,
+            int n),
+        CCbigguy_wide_dot_sparse (CCbigguy_wide *w, const CCbigguy *y,
+            const int *ind, const int *m, int n),
+        CCbigguy_wide_sum (CCbigguy_wide *w, const CCbigguy *y, int n),
+        CCbigguy_wide_merge (CCbigguy_wide *w, const CCbigguy_wide *v);
+
+    int
+        CCbigguy_wide_sign (CCbigguy_wide *w),
+        CCbigguy_wide_narrow (CCbigguy_wide *w, CCbigguy *x);
+
+
+typedef struct CCbigguy_vec {
+    int n;
+    unsigned int *ihi;
+    unsigned int *ilo;
+    unsigned int *fhi;
+    unsigned int *flo;
+    char *mem;
+} CCbigguy_vec;
+
+    int
+        CCbigguy_vec_init (CCbigguy_vec *v, int n),
+        CCbigguy_vec_add (CCbigguy_vec *x, const CCbigguy_vec *y),
+        CCbigguy_vec_sub (CCbigguy_vec *x, const CCbigguy_vec *y),
+        CCbigguy_vec_addmult (CCbigguy_vec *x, const CCbigguy_vec *y,
+            const int *m),
+        CCbigguy_vec_ceil (CCbigguy_vec *x);
+
+    void
+        CCbigguy_vec_free (CCbigguy_vec *v),
+        CCbigguy_vec_set (CCbigguy_vec *v, int i, CCbigguy x),
+        CCbigguy_vec_cmp (const CCbigguy_vec *x, CCbigguy y, int *cmp),
+        CCbigguy_vec_bigguytod (const CCbigguy_vec *x, double *d);
 
     CCbigguy
-        CCbigguy_itobigguy (int d),
-        CCbigguy_dtobigguy (double d),
-        CCbigguy_ceil (CCbigguy x);
+        CCbigguy_vec_get (const CCbigguy_vec *v, int i);
+
+typedef struct CCbigguy_packed {
+    int n;
+    int width;                  /* 8 or 12 bytes per value */
+    unsigned long long *mid;    /* ilo:fhi, or an escape */
+    unsigned int *lo;           /* flo, if width is 12 */
+    CCbigguy *esc;              /* the values that do not fit */
+    int nesc;
+    int escspace;
+} CCbigguy_packed;
+
+    int
+        CCbigguy_packed_init (CCbigguy_packed *p, int n, int width),
+        CCbigguy_packed_set (CCbigguy_packed *p, int i, CCbigguy x),
+        CCbigguy_packed_sum_chk (CCbigguy *acc, const CCbigguy_packed *y),
+        CCbigguy_packed_dot_chk (CCbigguy *acc, const CCbigguy_packed *y,
+            const int *m);
+
+    void
+        CCbigguy_packed_free (CCbigguy_packed *p),
+        CCbigguy_packed_cmp (const CCbigguy_packed *x, CCbigguy y, int *cmp);
+
+    CCbigguy
+        CCbigguy_packed_get (const CCbigguy_packed *p, int i);
+
+typedef struct CCbigguy_hybrid {
+    long long val;        /* the value times 2^32, if isbig is 0 */
+    CCbigguy big;
+    int isbig;
+} CCbigguy_hybrid;
+
+    int
+        CCbigguy_hybrid_addmult_chk (CCbigguy_hybrid *h, CCbigguy y, int m),
+        CCbigguy_hybrid_cmp (const CCbigguy_hybrid *h, CCbigguy y);
+
+    void
+        CCbigguy_hybrid_init (CCbigguy_hybrid *h, CCbigguy x),
+        CCbigguy_hybrid_add (CCbigguy_hybrid *h, CCbigguy y),
+        CCbigguy_hybrid_sub (CCbigguy_hybrid *h, CCbigguy y),
+        CCbigguy_hybrid_addmult (CCbigguy_hybrid *h, CCbigguy y, int m);
+
+    CCbigguy
+        CCbigguy_hybrid_get (const CCbigguy_hybrid *h);
+
+#define CCbigguy_DSUM_LANES 70
+
+typedef struct CCbigguy_dsum {
+    long long lane[CCbigguy_DSUM_LANES];
+    int pending;
+    int bad;              /* an infinity or NaN was added */
+} CCbigguy_dsum;
+
+    void
+        CCbigguy_dsum_init (CCbigguy_dsum *s),
+        CCbigguy_dsum_add (CCbigguy_dsum *s, double d),
+        CCbigguy_dsum_addmult (CCbigguy_dsum *s, double d, int m),
+        CCbigguy_dsum_add_array (CCbigguy_dsum *s, const double *d, int n),
+        CCbigguy_dsum_dot (CCbigguy_dsum *s, const double *d, const int *m,
+            int n);
+
+    int
+        CCbigguy_dsum_get (CCbigguy_dsum *s, CCbigguy *x);
+
+    int
+        CCbigguy_par_sum_chk (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, int n),
+        CCbigguy_par_dot_chk (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *m, int n),
+        CCbigguy_par_dot_sparse_chk (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *ind, const int *m, int n);
+
+    void
+        CCbigguy_par_sum (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, int n),
+        CCbigguy_par_dot (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *m, int n),
+        CCbigguy_par_dot_sparse (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *ind, const int *m, int n),
+        CCbigguy_spmv (CCbigguy_pool *pool, int nrows, const int *rowbeg,
+            const int *colind, const int *val, const CCbigguy *pi,
+            CCbigguy *out);
+
+    int
+        CCbigguy_spmv_chk (CCbigguy_pool *pool, int nrows, const int *rowbeg,
+            const int *colind, const int *val, const CCbigguy *pi,
+            CCbigguy *out),
+        CCbigguy_spmv_viol (CCbigguy_pool *pool, int nrows,
+            const int *rowbeg, const int *colind, const int *val,
+            const CCbigguy *pi, const CCbigguy *bound, int *viol);
+
+    int
+        CCbigguy_scan_incl_chk (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *m, int n, CCbigguy *out),
+        CCbigguy_scan_excl_chk (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *m, int n, CCbigguy *out);
+
+    void
+        CCbigguy_scan_incl (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *m, int n, CCbigguy *out),
+        CCbigguy_scan_excl (CCbigguy_pool *pool, CCbigguy *acc,
+            const CCbigguy *y, const int *m, int n, CCbigguy *out);
+
+typedef struct CCbigguy_atomic {
+    CCbigguy val;
+} CCbigguy_ALIGN16 CCbigguy_atomic;
+
+    int
+        CCbigguy_atomic_addmult_chk (CCbigguy_atomic *a, CCbigguy y, int m),
+        CCbigguy_atomic_add_chk (CCbigguy_atomic *a, CCbigguy y);
+
+    void
+        CCbigguy_atomic_init (CCbigguy_atomic *a, CCbigguy x),
+        CCbigguy_atomic_addmult (CCbigguy_atomic *a, CCbigguy y, int m),
+        CCbigguy_atomic_add (CCbigguy_atomic *a, CCbigguy y),
+        CCbigguy_atomic_max (CCbigguy_atomic *a, CCbigguy y);
+
+    CCbigguy
+        CCbigguy_atomic_load (CCbigguy_atomic *a);
+
+    int
+        CCbigguy_array_argmin (const CCbigguy *x, int n),
+        CCbigguy_array_argmax (const CCbigguy *x, int n),
+        CCbigguy_array_count_below (const CCbigguy *x, int n,
+            CCbigguy bound),
+        CCbigguy_array_topk (const CCbigguy *x, int n, int k, int *ind),
+        CCbigguy_radixsort (CCbigguy *x, int n),
+        CCbigguy_perm_radixsort (int *perm, const CCbigguy *x, int n);
+
+    CCbigguy
+        CCbigguy_array_min (const CCbigguy *x, int n),
+        CCbigguy_array_max (const CCbigguy *x, int n);
+
+    int
+        CCbigguy_cpu_select (const char *name);
+
+    const char
+        *CCbigguy_cpu_name (void);
+
+    int
+        CCbigguy_mul_chk (CCbigguy *x, CCbigguy y, int round),
+        CCbigguy_addmult_bigguy_chk (CCbigguy *x, CCbigguy y, CCbigguy z,
+            int round),
+        CCbigguy_mul_double_chk (CCbigguy *x, double d, int round),
+        CCbigguy_divint_chk (CCbigguy *x, int d, int round);
+
+    void
+        CCbigguy_mul (CCbigguy *x, CCbigguy y, int round),
+        CCbigguy_addmult_bigguy (CCbigguy *x, CCbigguy y, CCbigguy z,
+            int round),
+        CCbigguy_mul_double (CCbigguy *x, double d, int round),
+        CCbigguy_divint (CCbigguy *x, int d, int round);
+
+#define CCbigguy_STAT_ADD       0
+#define CCbigguy_STAT_SUB       1
+#define CCbigguy_STAT_ADDMULT   2
+#define CCbigguy_STAT_CMP       3
+#define CCbigguy_STAT_CEIL      4
+#define CCbigguy_STAT_DOT       5
+#define CCbigguy_STAT_DTOBIGGUY 6
+#define CCbigguy_STAT_BIGGUYTOD 7
+#define CCbigguy_STAT_NOPS      8
+
+#define CCbigguy_STAT_OVERFLOW  4   /* carry[op][4] counts the overflows */
+
+typedef struct CCbigguy_stats {
+    unsigned long long calls[CCbigguy_STAT_NOPS];
+    unsigned long long carry[CCbigguy_STAT_NOPS][CCbigguy_STAT_OVERFLOW + 1];
+                                  /* by the highest limb a carry reached */
+    unsigned long long mult[65];  /* addmult multipliers by bits of |m| */
+    unsigned long long mhi;       /* multipliers outside 32-bit ints */
+    unsigned long long mag[129];  /* results, |x| in [2^(i-65), 2^(i-64)) */
+    unsigned long long frac[65];  /* results by fraction bits used */
+} CCbigguy_stats;
+
+    void
+        CCbigguy_stats_get (CCbigguy_stats *s),
+        CCbigguy_stats_reset (void),
+        CCbigguy_stats_dump (FILE *out),
+        CCbigguy_stats_arith (int op, const CCbigguy *x, CCbigguy y,
+            long long m, const CCbigguy *r),
+        CCbigguy_stats_calls (int op, int n),
+        CCbigguy_stats_result (int op, const CCbigguy *r, int n);
+
+/* the statistics count the exported routines, so they need those called */
+
+#ifdef CC_BIGGUY_STATS
+#undef CC_BIGGUY_INLINE
+#endif
+
+#ifdef CC_BIGGUY_INLINE
+#include "bg_inline.h"
+#undef CCbigguy_add
+#undef CCbigguy_sub
+#undef CCbigguy_addmult
+#undef CCbigguy_addmult_ll
+#undef CCbigguy_ceil
+#undef CCbigguy_cmp
+#undef CCbigguy_add_chk
+#undef CCbigguy_sub_chk
+#undef CCbigguy_addmult_chk
+#undef CCbigguy_addmult_ll_chk
+#undef CCbigguy_ceil_chk
+#define CCbigguy_add(x,y) CCbigguy_inline_add(x,y)
+#define CCbigguy_sub(x,y) CCbigguy_inline_sub(x,y)
+#define CCbigguy_addmult(x,y,m) CCbigguy_inline_addmult(x,y,m)
+#define CCbigguy_addmult_ll(x,y,m) CCbigguy_inline_addmult_ll(x,y,m)
+#define CCbigguy_ceil(x) CCbigguy_inline_ceil(x)
+#define CCbigguy_cmp(x,y) CCbigguy_inline_cmp(x,y)
+#define CCbigguy_add_chk(x,y) CCbigguy_inline_add_chk(x,y)
+#define CCbigguy_sub_chk(x,y) CCbigguy_inline_sub_chk(x,y)
+#define CCbigguy_addmult_chk(x,y,m) CCbigguy_inline_addmult_chk(x,y,m)
+#define CCbigguy_addmult_ll_chk(x,y,m) CCbigguy_inline_addmult_ll_chk(x,y,m)
+#define CCbigguy_ceil_chk(x) CCbigguy_inline_ceil_chk(x)
+#endif
 
 
 #endif /* CC_BIGGUY_BUILTIN */
 
-#define CCbigguy_add(x,y) (CCbigguy_addmult(x,y,1))
-#define CCbigguy_sub(x,y) (CCbigguy_addmult(x,y,-1))
+#define CCbigguy_FMT_FIXED   0
+#define CCbigguy_FMT_COMPACT 1
+
+int
+    CCbigguy_swrite_compact (CC_SFILE *f, CCbigguy x),
+    CCbigguy_sread_compact (CC_SFILE *f, CCbigguy *x),
+    CCbigguy_swrite_array_fmt (CC_SFILE *f, const CCbigguy *x, int n,
+        int fmt),
+    CCbigguy_sread_array_fmt (CC_SFILE *f, CCbigguy *x, int n, int fmt);
+
+#define CCbigguy_MAP_VERSION 1
 
+typedef struct CCbigguy_map {
+    const CCbigguy *x;
+    int n;
+    void *base;
+    size_t len;
+} CCbigguy_map;
 
 int
-    CCbigguy_swrite (CC_SFILE *f, CCbigguy x),
-    CCbigguy_sread (CC_SFILE *f, CCbigguy *x);
+    CCbigguy_map_write (const char *fname, const CCbigguy *x, int n),
+    CCbigguy_map_open (CCbigguy_map *m, const char *fname, int verify);
+
+void
+    CCbigguy_map_close (CCbigguy_map *m);
 
 
 #endif /* __BIGGUY_H */
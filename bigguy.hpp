@@ -0,0 +1,409 @@
+/****************************************************************************/
+/*                                                                          */
+/*  This file is part of CONCORDE                                           */
+/*                                                                          */
+/*  (c) Copyright 1995--1999 by David Applegate, Robert Bixby,              */
+/*  Vasek Chvatal, and William Cook                                         */
+/*                                                                          */
+/*  Permission is granted for academic research use.  For other uses,       */
+/*  contact the authors for licensing options.                              */
+/*                                                                          */
+/*  Use at your own risk.  We make no guarantees about the                  */
+/*  correctness or usefulness of this code.                                 */
+/*                                                                          */
+/****************************************************************************/
+
+/****************************************************************************/
+/*                                                                          */
+/*  concorde::bigguy<IntBits, FracBits> (C++14, header only)                */
+/*                                                                          */
+/*  A signed two's complement fixed point number with IntBits integer      */
+/*  bits (including the sign) and FracBits fraction bits, kept as           */
+/*  (IntBits+FracBits)/32 unsigned ints, most significant first.  The       */
+/*  sum must be a multiple of 32; the point may fall inside a limb, so      */
+/*  bigguy<48,16> is a single 64-bit word and bigguy<96,32> is three        */
+/*  limbs.  bigguy<64,64> has the layout of the C CCbigguy.                 */
+/*                                                                          */
+/*  The limb count is a template constant, so the carry chains and the      */
+/*  overflow tests are unrolled by the compiler.  Construction from int,    */
+/*  comparison and the arithmetic are constexpr; an overflow during         */
+/*  constant evaluation is a compile error, and at run time it goes to      */
+/*  CCbigguy_overflow, like the C routines.                                 */
+/*                                                                          */
+/*    bigguy (int d)                                                        */
+/*      d, exactly.  Overflows if d does not fit in IntBits.                */
+/*                                                                          */
+/*    +, -, +=, -=, unary -, ==, !=, <, <=, >, >=                           */
+/*      As for integers; +, - and unary - abort on overflow.                */
+/*                                                                          */
+/*    void addmult (const bigguy &y, int m)                                 */
+/*    bool add_chk (const bigguy &y)                                        */
+/*    bool sub_chk (const bigguy &y)                                        */
+/*    bool addmult_chk (const bigguy &y, int m)                             */
+/*      x += y*m, and the non-aborting forms, which return true (with x     */
+/*      unchanged) on overflow.                                             */
+/*                                                                          */
+/*    bigguy ceil () const                                                  */
+/*    int cmp (const bigguy &y) const                                       */
+/*    double to_double () const                                             */
+/*                                                                          */
+/*    template <int I2, int F2> static bigguy convert                       */
+/*        (const bigguy<I2,F2> &y, bool *ovf)                               */
+/*      y in this format, truncating extra fraction bits toward -infinity.  */
+/*      Sets *ovf (if ovf is not NULL) when the integer part does not fit.  */
+/*                                                                          */
+/*    static bigguy from_c (CCbigguy y)                                     */
+/*    CCbigguy to_c () const                                                */
+/*      Conversion to and from the C type (through bigguy<64,64>); to_c     */
+/*      aborts if the value does not fit.                                   */
+/*                                                                          */
+/****************************************************************************/
+
+#ifndef  __BIGGUY_HPP
+#define  __BIGGUY_HPP
+
+extern "C" {
+#include "bigguy.h"
+}
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace concorde {
+
+template <int IntBits, int FracBits>
+class bigguy {
+public:
+    static_assert (IntBits >= 1 && FracBits >= 0,
+                   "bigguy needs a sign bit and a nonnegative fraction");
+    static_assert ((IntBits + FracBits) % 32 == 0,
+                   "IntBits + FracBits must be a multiple of 32");
+
+    static constexpr int nlimbs = (IntBits + FracBits) / 32;
+    static constexpr int intbits = IntBits;
+    static constexpr int fracbits = FracBits;
+
+    unsigned int limb[nlimbs];    /* limb[0] is the most significant */
+
+    constexpr bigguy () : limb {} { }
+
+    constexpr bigguy (int d) : limb {}
+    {
+        for (int i = 0; i < nlimbs; i++) {
+            limb[nlimbs - 1 - i] = bits_of_int (d, 32 * i - FracBits);
+        }
+        if (IntBits < 32 && (d >= (1LL << (small_int - 1)) ||
+                             d < -(1LL << (small_int - 1)))) {
+            CCbigguy_overflow ("bigguy::bigguy (int)");
+        }
+    }
+
+    static constexpr bigguy max ()
+    {
+        bigguy x;
+        for (int i = 0; i < nlimbs; i++) x.limb[i] = 0xffffffffu;
+        x.limb[0] = 0x7fffffffu;
+        return x;
+    }
+
+    static constexpr bigguy min ()
+    {
+        bigguy x;
+        x.limb[0] = 0x80000000u;
+        x.limb[nlimbs - 1] |= 1u;
+        return x;
+    }
+
+    constexpr bool negative () const
+    {
+        return (limb[0] >> 31) != 0;
+    }
+
+    /* bits [b, b+32) of the raw two's complement value, for any b */
+
+    constexpr unsigned int bits (int b) const
+    {
+        unsigned int fill = negative () ? 0xffffffffu : 0;
+        unsigned long long w = 0;
+        int k = 0, s = 0;
+
+        if (b <= -32) return 0;
+        if (b >= 32 * nlimbs) return fill;
+        k = (b >= 0) ? b / 32 : -1;
+        s = b - 32 * k;
+        w = ((unsigned long long) limb_or (k + 1, fill) << 32) |
+            limb_or (k, fill);
+        return (unsigned int) (w >> s);
+    }
+
+    constexpr int cmp (const bigguy &y) const
+    {
+        if ((int) limb[0] != (int) y.limb[0]) {
+            return ((int) limb[0] < (int) y.limb[0]) ? -1 : 1;
+        }
+        for (int i = 1; i < nlimbs; i++) {
+            if (limb[i] != y.limb[i]) return (limb[i] < y.limb[i]) ? -1 : 1;
+        }
+        return 0;
+    }
+
+    constexpr bool add_chk (const bigguy &y)
+    {
+        bigguy z;
+        unsigned long long carry = 0;
+
+        for (int i = nlimbs - 1; i >= 0; i--) {
+            carry += (unsigned long long) limb[i] + y.limb[i];
+            z.limb[i] = (unsigned int) carry;
+            carry >>= 32;
+        }
+        /* overflow iff x and y have the same sign and the sum does not */
+        if (((limb[0] ^ z.limb[0]) & (y.limb[0] ^ z.limb[0])) >> 31) {
+            return true;
+        }
+        *this = z;
+        return false;
+    }
+
+    constexpr bool sub_chk (const bigguy &y)
+    {
+        bigguy z;
+        unsigned long long carry = 1;
+
+        for (int i = nlimbs - 1; i >= 0; i--) {
+            carry += (unsigned long long) limb[i] + (unsigned int) ~y.limb[i];
+            z.limb[i] = (unsigned int) carry;
+            carry >>= 32;
+        }
+        /* overflow iff x and y differ in sign and x - y has y's sign */
+        if (((limb[0] ^ y.limb[0]) & (limb[0] ^ z.limb[0])) >> 31) {
+            return true;
+        }
+        *this = z;
+        return false;
+    }
+
+    constexpr bool addmult_chk (const bigguy &y, int m)
+    {
+        unsigned int p[nlimbs + 1] = {};
+        long long t = 0;
+        unsigned long long carry = 0;
+        bigguy z;
+        unsigned int top = 0;
+
+        /* p = y*m in nlimbs+1 limbs; each step fits in a long long */
+        for (int i = nlimbs - 1; i > 0; i--) {
+            t += (long long) y.limb[i] * m;
+            p[i + 1] = (unsigned int) t;
+            t >>= 32;
+        }
+        t += (long long) (int) y.limb[0] * m;
+        p[1] = (unsigned int) t;
+        p[0] = (unsigned int) (t >> 32);
+
+        /* z = x + p, with x sign extended to nlimbs+1 limbs */
+        for (int i = nlimbs - 1; i >= 0; i--) {
+            carry += (unsigned long long) limb[i] + p[i + 1];
+            z.limb[i] = (unsigned int) carry;
+            carry >>= 32;
+        }
+        top = (unsigned int) (carry + p[0] + (negative () ? 0xffffffffu : 0));
+
+        if (top != (z.negative () ? 0xffffffffu : 0)) return true;
+        *this = z;
+        return false;
+    }
+
+    constexpr void addmult (const bigguy &y, int m)
+    {
+        if (addmult_chk (y, m)) CCbigguy_overflow ("bigguy::addmult");
+    }
+
+    constexpr bigguy &operator+= (const bigguy &y)
+    {
+        if (add_chk (y)) CCbigguy_overflow ("bigguy::operator+");
+        return *this;
+    }
+
+    constexpr bigguy &operator-= (const bigguy &y)
+    {
+        if (sub_chk (y)) CCbigguy_overflow ("bigguy::operator-");
+        return *this;
+    }
+
+    constexpr bigguy operator- () const
+    {
+        bigguy z;
+        z -= *this;
+        return z;
+    }
+
+    constexpr bigguy ceil () const
+    {
+        bigguy z = *this;
+        bool frac = false;
+        int i = nlimbs - 1;
+
+        for (; 32 * (nlimbs - 1 - i) + 32 <= FracBits; i--) {
+            frac = frac || z.limb[i] != 0;
+            z.limb[i] = 0;
+        }
+        if (FracBits % 32) {
+            unsigned int mask = (1u << (FracBits % 32)) - 1;
+            frac = frac || (z.limb[i] & mask) != 0;
+            z.limb[i] &= ~mask;
+        }
+        if (frac && z.add_chk (ulp_one ())) {
+            CCbigguy_overflow ("bigguy::ceil");
+        }
+        return z;
+    }
+
+    double to_double () const
+    {
+        double d = (double) (int) limb[0];
+
+        for (int i = 1; i < nlimbs; i++) {
+            d = d * 4294967296.0 + (double) limb[i];
+        }
+        return std::ldexp (d, -FracBits);
+    }
+
+    template <int I2, int F2>
+    static constexpr bigguy convert (const bigguy<I2, F2> &y, bool *ovf)
+    {
+        bigguy z;
+        unsigned int fill = y.negative () ? 0xffffffffu : 0;
+        int shift = F2 - FracBits;
+
+        for (int i = 0; i < nlimbs; i++) {
+            z.limb[nlimbs - 1 - i] = y.bits (32 * i + shift);
+        }
+        /* the source bits from our sign bit up must all be sign fill */
+        if (ovf) {
+            bool bad = (z.negative () != y.negative ());
+            for (int b = 32 * nlimbs + shift; b < 32 * y.nlimbs; b += 32) {
+                bad = bad || y.bits (b) != fill;
+            }
+            *ovf = bad;
+        }
+        return z;
+    }
+
+#ifndef CC_BIGGUY_BUILTIN
+    static bigguy from_c (const CCbigguy &y)
+    {
+        bigguy<64, 64> c;
+        bool ovf = false;
+        bigguy z;
+
+        c.limb[0] = y.ihi;
+        c.limb[1] = y.ilo;
+        c.limb[2] = y.fhi;
+        c.limb[3] = y.flo;
+        z = convert (c, &ovf);
+        if (ovf) CCbigguy_overflow ("bigguy::from_c");
+        return z;
+    }
+
+    CCbigguy to_c () const
+    {
+        bool ovf = false;
+        bigguy<64, 64> c = bigguy<64, 64>::convert (*this, &ovf);
+        CCbigguy y;
+
+        if (ovf) CCbigguy_overflow ("bigguy::to_c");
+        y.ihi = c.limb[0];
+        y.ilo = c.limb[1];
+        y.fhi = c.limb[2];
+        y.flo = c.limb[3];
+        return y;
+    }
+#endif
+
+private:
+    static constexpr int small_int = (IntBits < 32) ? IntBits : 32;
+
+    static constexpr unsigned int bits_of_int (int d, int b)
+    {
+        long long v = d;
+
+        if (b <= -32) return 0;
+        if (b < 0) return (unsigned int) ((unsigned long long) v << -b);
+        if (b >= 32) return (d < 0) ? 0xffffffffu : 0;
+        return (unsigned int) (v >> b);
+    }
+
+    /* limb k counted from the least significant end, sign filled */
+
+    constexpr unsigned int limb_or (int k, unsigned int fill) const
+    {
+        return (k < 0) ? 0 : (k >= nlimbs) ? fill : limb[nlimbs - 1 - k];
+    }
+
+    static constexpr bigguy ulp_one ()
+    {
+        bigguy x;
+        x.limb[nlimbs - 1 - FracBits / 32] = 1u << (FracBits % 32);
+        return x;
+    }
+};
+
+template <int I, int F>
+constexpr bigguy<I, F> operator+ (bigguy<I, F> x, const bigguy<I, F> &y)
+{
+    return x += y;
+}
+
+template <int I, int F>
+constexpr bigguy<I, F> operator- (bigguy<I, F> x, const bigguy<I, F> &y)
+{
+    return x -= y;
+}
+
+template <int I, int F>
+constexpr bool operator== (const bigguy<I, F> &x, const bigguy<I, F> &y)
+{
+    return x.cmp (y) == 0;
+}
+
+template <int I, int F>
+constexpr bool operator!= (const bigguy<I, F> &x, const bigguy<I, F> &y)
+{
+    return x.cmp (y) != 0;
+}
+
+template <int I, int F>
+constexpr bool operator< (const bigguy<I, F> &x, const bigguy<I, F> &y)
+{
+    return x.cmp (y) < 0;
+}
+
+template <int I, int F>
+constexpr bool operator<= (const bigguy<I, F> &x, const bigguy<I, F> &y)
+{
+    return x.cmp (y) <= 0;
+}
+
+template <int I, int F>
+constexpr bool operator> (const bigguy<I, F> &x, const bigguy<I, F> &y)
+{
+    return x.cmp (y) > 0;
+}
+
+template <int I, int F>
+constexpr bool operator>= (const bigguy<I, F> &x, const bigguy<I, F> &y)
+{
+    return x.cmp (y) >= 0;
+}
+
+#ifndef CC_BIGGUY_BUILTIN
+static_assert (sizeof (bigguy<64, 64>) == sizeof (CCbigguy) &&
+               std::is_standard_layout<bigguy<64, 64> >::value,
+               "bigguy<64,64> must have the CCbigguy layout");
+#endif
+
+}
+
+#endif /* __BIGGUY_HPP */